@@ -3,7 +3,7 @@ INCLUDEPATH += $$PWD
 
 LIBS += -lutil
 
-CONFIG += c++11
+CONFIG += c++14
 
 MOC_DIR = .moc
 OBJECTS_DIR = .obj
@@ -13,15 +13,22 @@ HEADERS += \
            $$PWD/text.h \
            $$PWD/controll_chars.h \
            $$PWD/parser.h \
+           $$PWD/csi_parameters.h \
            $$PWD/screen.h \
            $$PWD/block.h \
+           $$PWD/block_renderer.h \
+           $$PWD/byte_ring.h \
            $$PWD/color_palette.h \
            $$PWD/text_style.h \
            $$PWD/screen_data.h \
            $$PWD/cursor.h \
-           $$PWD/nrc_text_codec.h \
+           $$PWD/character_decoder.h \
+           $$PWD/char_width.h \
+           $$PWD/char_width_table.h \
            $$PWD/scrollback.h \
            $$PWD/utf8_decoder.h \
+           $$PWD/vt_state_machine.h \
+           $$PWD/text_scanner.h \
            $$PWD/selection.h
 
 SOURCES += \
@@ -32,13 +39,17 @@ SOURCES += \
            $$PWD/screen.cpp \
            $$PWD/screen_keyboard.cpp \
            $$PWD/block.cpp \
+           $$PWD/byte_ring.cpp \
            $$PWD/color_palette.cpp \
            $$PWD/text_style.cpp \
            $$PWD/screen_data.cpp \
            $$PWD/cursor.cpp \
-           $$PWD/nrc_text_codec.cpp \
+           $$PWD/character_decoder.cpp \
+           $$PWD/char_width.cpp \
            $$PWD/scrollback.cpp \
-           $$PWD/selection.cpp
+           $$PWD/utf8_decoder.cpp \
+           $$PWD/selection.cpp \
+           $$PWD/text_scanner.cpp
 
 coverage {
     clang: {
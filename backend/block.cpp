@@ -23,6 +23,8 @@
 
 #include "block.h"
 
+#include "block_renderer.h"
+#include "char_width.h"
 #include "text.h"
 #include "screen.h"
 
@@ -32,9 +34,13 @@
 #include <QtCore/QDebug>
 
 #include <algorithm>
+#include <climits>
+#include <cstring>
 
 Block::Block(Screen *screen)
     : m_screen(screen)
+    , m_text_dirty_from(INT_MAX)
+    , m_style_list_dirty(true)
     , m_line(0)
     , m_new_line(-1)
     , m_screen_index(0)
@@ -48,6 +54,8 @@ Block::Block(Screen *screen)
 
 Block::~Block()
 {
+    if (BlockRenderer *renderer = m_screen->blockRenderer())
+        renderer->blockReleased(this);
     for (int i = 0; i < m_style_list.size(); i++) {
         m_style_list[i].releaseTextSegment(m_screen);
     }
@@ -60,13 +68,17 @@ Screen *Block::screen() const
 
 void Block::clear()
 {
+    m_cells.clear();
     m_text_line.clear();
+    m_text_dirty_from = INT_MAX;
 
     for (int i = 0; i < m_style_list.size(); i++) {
         m_style_list[i].releaseTextSegment(m_screen);
     }
 
     m_style_list.clear();
+    m_dirty_lines.clear();
+    m_style_list_dirty = true;
 
     m_only_latin = true;
     m_changed = true;
@@ -74,81 +86,35 @@ void Block::clear()
 
 void Block::clearToEnd(int from)
 {
-    clearCharacters(from, m_text_line.size() - 1);
+    clearCharacters(from, m_cells.size() - 1);
 }
 
 void Block::clearCharacters(int from, int to)
 {
-    if (from > m_text_line.size())
+    if (from > m_cells.size())
         return;
 
     QString empty(to+1-from, QChar(' '));
-    const TextStyle &defaultTextStyle = m_screen->defaultTextStyle();
-    replaceAtPos(from, empty, defaultTextStyle);
+    replaceAtPos(from, empty, m_screen->defaultStyleId());
 }
 
 void Block::deleteCharacters(int from, int to)
 {
-    m_changed = true;
-
-    int removed = 0;
-    const int size = (to + 1) - from;
-    bool found = false;
-
-    for (int i = 0; i < m_style_list.size(); i++) {
-        TextStyleLine &current_style = m_style_list[i];
-        if (found) {
-            current_style.start_index -= removed;
-            current_style.end_index -= removed;
-            current_style.index_dirty = true;
-            if (removed != size) {
-                int current_style_size = current_style.end_index + 1  - current_style.start_index;
-                if (current_style_size <= size - removed) {
-                    removed += current_style.end_index + 1 - current_style.start_index;
-                    current_style.releaseTextSegment(m_screen);
-                    m_style_list.remove(i);
-                    i--;
-                } else {
-                    current_style.end_index -= size - removed;
-                    removed = size;
-                }
-            }
-        } else {
-            if (current_style.start_index <= from && current_style.end_index >= from) {
-                found = true;
-                int left_in_style = (current_style.end_index + 1) - from;
-                int subtract = std::min(left_in_style, size);
-                current_style.end_index -= subtract;
-                current_style.text_dirty = true;
-                removed = subtract;
-                if (current_style.end_index < current_style.start_index) {
-                    current_style.releaseTextSegment(m_screen);
-                    m_style_list.remove(i);
-                    i--;
-                }
-            }
-        }
-    }
+    if (from >= m_cells.size() || to < from)
+        return;
 
-    if (!m_style_list.isEmpty()) {
-        int lastIndex = m_style_list.size() - 1;
-        TextStyleLine &last_modified = m_style_list[lastIndex];
-        TextStyle defaultStyle = m_screen->defaultTextStyle();
-        if (last_modified.isCompatible(defaultStyle)) {
-            last_modified.end_index += size;
-            last_modified.text_dirty = true;
-        } else {
-            m_style_list.insert(lastIndex + 1, TextStyleLine(defaultStyle,
-                        last_modified.end_index + 1, last_modified.end_index + size));
-        }
+    const int size = std::min(to + 1, m_cells.size()) - from;
+    if (!m_only_latin) {
+        breakWideCharacter(from);
+        breakWideCharacter(from + size);
     }
-
-    m_text_line.remove(from, size);
+    m_cells.remove(from, size);
+    markDirty(from, m_cells.size() + size - 1);
 }
 
 void Block::deleteToEnd(int from)
 {
-    deleteCharacters(from, m_text_line.size() - 1);
+    deleteCharacters(from, m_cells.size() - 1);
 }
 
 void Block::deleteLines(int from)
@@ -159,172 +125,112 @@ void Block::deleteLines(int from)
 
 void Block::replaceAtPos(int pos, const QString &text, const TextStyle &style, bool only_latin)
 {
-    m_changed = true;
-    m_only_latin = m_only_latin && only_latin;
+    replaceAtPos(pos, text, m_screen->styleTable().intern(style), only_latin);
+}
 
-    if (pos >= m_text_line.size()) {
-        if (pos > m_text_line.size()) {
-            int old_size = m_text_line.size();
-            QString filling(pos - m_text_line.size(), QChar(' '));
-            m_text_line.append(filling);
-            m_style_list.append(TextStyleLine(m_screen->defaultTextStyle(), old_size, old_size + filling.size() -1));
-        }
-        m_text_line.append(text);
-        m_style_list.append(TextStyleLine(style, pos, pos + text.size()-1));
-        return;
-    } else if (pos + text.size() > m_text_line.size()) {
-        m_style_list.append(TextStyleLine(m_screen->defaultTextStyle(), pos + text.size() - m_text_line.size(), pos + text.size() -1));
+void Block::replaceAtPos(int pos, const QString &text, quint16 style, bool only_latin)
+{
+    if (!m_only_latin) {
+        breakWideCharacter(pos);
+        breakWideCharacter(pos + text.size());
     }
+    m_only_latin = m_only_latin && only_latin;
 
-    m_text_line.replace(pos,text.size(),text);
-    bool found = false;
-    for (int i = 0; i < m_style_list.size(); i++) {
-        TextStyleLine &current_style = m_style_list[i];
-        if (found) {
-            if (current_style.end_index <= pos + text.size() - 1) {
-                current_style.releaseTextSegment(m_screen);
-                m_style_list.remove(i);
-                i--;
-            } else if (current_style.start_index <= pos + text.size()) {
-                current_style.start_index = pos + text.size();
-                current_style.style_dirty = true;
-                current_style.text_dirty = true;
-                current_style.index_dirty = true;
-            } else {
-                break;
-            }
-        } else if (pos >= current_style.start_index && pos <= current_style.end_index) {
-            found = true;
-            if (pos + text.size() -1 <= current_style.end_index) {
-                if (current_style.isCompatible(style)) {
-                    current_style.text_dirty = true;
-                } else {
-                    if (current_style.start_index == pos && current_style.end_index == pos + text.size() - 1) {
-                        current_style.setStyle(style);
-                        current_style.text_dirty = true;
-                        current_style.style_dirty = true;
-                    } else if (current_style.start_index == pos) {
-                        current_style.start_index = pos + text.size();
-                        current_style.text_dirty = true;
-                        m_style_list.insert(i, TextStyleLine(style,pos, pos+text.size() -1));
-                    } else if (current_style.end_index == pos + text.size() - 1) {
-                        current_style.end_index = pos - 1;
-                        current_style.text_dirty = true;
-                        m_style_list.insert(i+1, TextStyleLine(style,pos, pos + text.size() - 1));
-                    } else {
-                        int old_end = current_style.end_index;
-                        current_style.end_index = pos - 1;
-                        current_style.text_dirty = true;
-
-                        // must copy here, as the following insert will invalidate current_style
-                        TextStyleLine newStyle(current_style, pos + text.size(), old_end);
-                        m_style_list.insert(i+1, TextStyleLine(style,pos, pos + text.size() - 1));
-
-                        if (pos + text.size() < m_text_line.size()) {
-                            m_style_list.insert(i+2, TextStyleLine(newStyle, pos + text.size(), old_end));
-                        }
-                    }
-                }
-                break;
-            } else {
-                if (current_style.isCompatible(style)) {
-                    current_style.end_index = pos + text.size() - 1;
-                    current_style.text_dirty = true;
-                } else {
-                    if (current_style.start_index == pos) {
-                        if (i > 0 && m_style_list.at(i-1).isCompatible(style)) {
-                            TextStyleLine &previous_style = m_style_list[i -1];
-                            previous_style.end_index+= text.size();
-                            previous_style.text_dirty = true;
-                            current_style.releaseTextSegment(m_screen);
-                            m_style_list.remove(i);
-                            i--;
-                        } else {
-                            current_style.end_index = pos + text.size() - 1;
-                            current_style.style = style.style;
-                            current_style.foreground = style.foreground;
-                            current_style.background = style.background;
-                            current_style.text_dirty = true;
-                            current_style.style_dirty = true;
-                            current_style.index_dirty = true;
-                        }
-                    } else {
-                        current_style.end_index = pos - 1;
-                        current_style.text_dirty = true;
-                        m_style_list.insert(i+1, TextStyleLine(style, pos, pos + text.size() -1));
-                        i++;
-                    }
-                }
-            }
-        }
+    if (pos > m_cells.size()) {
+        const int old_size = m_cells.size();
+        const TextCell filling = { QChar(' '), m_screen->defaultStyleId() };
+        m_cells.insert(old_size, pos - old_size, filling);
+        markDirty(old_size, pos - 1);
     }
+    if (pos + text.size() > m_cells.size())
+        m_cells.resize(pos + text.size());
+
+    fillCells(pos, text, style);
+    markDirty(pos, pos + text.size() - 1);
 }
 
 void Block::insertAtPos(int pos, const QString &text, const TextStyle &style, bool only_latin)
 {
-    m_changed = true;
-    m_only_latin = m_only_latin && only_latin;
-
-    m_text_line.insert(pos,text);
-    bool found = false;
+    insertAtPos(pos, text, m_screen->styleTable().intern(style), only_latin);
+}
 
-    for (int i = 0; i < m_style_list.size(); i++) {
-        TextStyleLine &current_style = m_style_list[i];
-        if (found) {
-            current_style.start_index += text.size();
-            current_style.end_index += text.size();
-            current_style.index_dirty = true;
-            if (current_style.start_index >= m_text_line.size()) {
-                current_style.releaseTextSegment(m_screen);
-                m_style_list.remove(i);
-                i--;
-            } else if (current_style.end_index >= m_text_line.size()) {
-                current_style.end_index = m_text_line.size()-1;
-            }
-        } else if (pos >= current_style.start_index && pos <= current_style.end_index) {
-            found = true;
-            if (current_style.start_index == pos) {
-                current_style.start_index += text.size();
-                current_style.end_index += text.size();
-                current_style.index_dirty = true;
-                m_style_list.insert(i, TextStyleLine(style, pos, pos+ text.size() - 1));
-                i++;
-            } else if (current_style.end_index == pos) {
-                current_style.end_index--;
-                current_style.text_dirty = true;
-                m_style_list.insert(i+1, TextStyleLine(style, pos, pos+ text.size() - 1));
-                i++;
-            } else {
-                int old_end = current_style.end_index;
-                current_style.end_index = pos -1;
-                current_style.text_dirty = true;
+void Block::insertAtPos(int pos, const QString &text, quint16 style, bool only_latin)
+{
+    if (!m_only_latin)
+        breakWideCharacter(pos);
+    m_only_latin = m_only_latin && only_latin;
 
-                // must copy here, as the following insert will invalidate current_style
-                int segment_end = std::min(m_text_line.size() -1, old_end + text.size());
-                TextStyleLine newStyle(current_style, pos + text.size(), segment_end);
-                m_style_list.insert(i+1, TextStyleLine(style, pos, pos + text.size() - 1));
-
-                if (pos + text.size() < m_text_line.size()) {
-                    m_style_list.insert(i+2, newStyle);
-                    i+=2;
-                } else {
-                    i++;
-                }
-            }
-        }
+    const int old_size = m_cells.size();
+    if (pos > old_size) {
+        const TextCell filling = { QChar(' '), m_screen->defaultStyleId() };
+        m_cells.insert(old_size, pos - old_size, filling);
     }
+    m_cells.insert(pos, text.size(), TextCell());
+
+    fillCells(pos, text, style);
+    markDirty(std::min(pos, old_size), m_cells.size() - 1);
 }
 
 QString Block::textLine() const
 {
+    syncTextLine();
     return m_text_line;
 }
 
+// Reads straight from the cells, so blocks that are only copied from do not
+// build a text line.
+void Block::appendText(QString *out, int from, int to) const
+{
+    const TextCell *src = m_cells.constData() + from;
+    if (m_only_latin) {
+        const int old_size = out->size();
+        out->resize(old_size + to - from);
+        QChar *dst = out->data() + old_size;
+        for (int i = 0; i < to - from; i++)
+            dst[i] = src[i].character;
+        return;
+    }
+
+    // Padding cells are left out, and clusters put back together.
+    const ClusterTable &clusters = m_screen->clusterTable();
+    for (int i = 0; i < to - from; i++) {
+        const QChar character = src[i].character;
+        if (ClusterTable::isCluster(character))
+            out->append(clusters.text(character));
+        else if (!CharWidth::isPadding(character))
+            out->append(character);
+    }
+}
+
+void Block::attachToCell(int pos, const QString &text)
+{
+    if (pos > 0 && pos < m_cells.size() && CharWidth::isPadding(m_cells.at(pos).character))
+        pos--;
+    if (pos < 0 || pos >= m_cells.size())
+        return;
+
+    ClusterTable &clusters = m_screen->clusterTable();
+    const QChar character = m_cells.at(pos).character;
+    const QString cluster = (ClusterTable::isCluster(character) ? clusters.text(character) : QString(character)) + text;
+    int columns;
+    m_cells[pos].character = CharWidth::cell(cluster, &clusters, &columns);
+    m_only_latin = false;
+    markDirty(pos, pos);
+}
+
+void Block::setCells(const QVector<TextCell> &cells, bool only_latin)
+{
+    m_cells = cells;
+    m_only_latin = only_latin;
+    markAllDirty();
+}
+
 void Block::setWidth(int width)
 {
     m_width = width;
+    markAllDirty();
 
-    if (width > m_text_line.size())
+    if (width > m_cells.size())
         return;
 
     releaseTextObjects();
@@ -352,27 +258,13 @@ Block *Block::split(int line)
 {
     if (line >= lineCount())
         return nullptr;
-    m_changed = true;
     Block *to_return = new Block(m_screen);
     int start_index = line * m_width;
-    for (int i = 0; i < m_style_list.size(); i++) {
-        ensureStyleAlignWithLines(i);
-        TextStyleLine &current_style = m_style_list[i];
-        if (current_style.start_index >= start_index) {
-            current_style.start_index -= start_index;
-            current_style.old_index = current_style.start_index - 1;
-            current_style.end_index -= start_index;
-            current_style.index_dirty = true;
-            current_style.text_dirty = true;
-            current_style.index_dirty = true;
-            to_return->m_style_list.append(TextStyleLine(current_style, current_style.start_index,
-                        current_style.end_index));
-            m_style_list.remove(i);
-            i--;
-        }
-    }
-    to_return->m_text_line = m_text_line.mid(start_index, m_text_line.size() - start_index);
-    m_text_line.remove(start_index, m_text_line.size() - start_index);
+    to_return->m_cells = m_cells.mid(start_index);
+    to_return->m_only_latin = m_only_latin;
+    to_return->markAllDirty();
+    m_cells.resize(start_index);
+    markAllDirty();
     return to_return;
 }
 
@@ -380,31 +272,13 @@ Block *Block::takeLine(int line)
 {
     if (line >= lineCount())
         return nullptr;
-    m_changed = true;
     Block *to_return = new Block(m_screen);
     int start_index = line * m_width;
-    int end_index = start_index + (m_width - 1);
-    for (int i = 0; i < m_style_list.size(); i++) {
-        ensureStyleAlignWithLines(i);
-        TextStyleLine &current_style = m_style_list[i];
-        if (current_style.start_index >= start_index && current_style.end_index <= end_index) {
-            current_style.releaseTextSegment(m_screen);
-            current_style.start_index -= start_index;
-            current_style.end_index -= start_index;
-            current_style.index_dirty = true;
-            to_return->m_style_list.append(TextStyleLine(current_style, current_style.start_index,
-                        current_style.end_index));
-            m_style_list.remove(i);
-            i--;
-        } else if (current_style.start_index > end_index) {
-            current_style.start_index -= (end_index + 1) - start_index;
-            current_style.end_index -= (end_index + 1) - start_index;
-            current_style.index_dirty = true;
-            current_style.text_dirty = true;
-        }
-    }
-    to_return->m_text_line = m_text_line.mid(start_index, m_width);
-    m_text_line.remove(start_index, m_width);
+    to_return->m_cells = m_cells.mid(start_index, m_width);
+    to_return->m_only_latin = m_only_latin;
+    to_return->markAllDirty();
+    m_cells.remove(start_index, std::min(m_width, m_cells.size() - start_index));
+    markAllDirty();
     return to_return;
 }
 
@@ -413,24 +287,9 @@ void Block::removeLine(int line)
     if (line >= lineCount())
         return;
 
-    m_changed = true;
     int start_index = line * m_width;
-    int end_index = start_index + (m_width - 1);
-    for (int i = 0; i < m_style_list.size(); i++) {
-        ensureStyleAlignWithLines(i);
-        TextStyleLine &current_style = m_style_list[i];
-        if (current_style.start_index >= start_index && current_style.end_index <= end_index) {
-            current_style.releaseTextSegment(m_screen);
-            m_style_list.remove(i);
-            i--;
-        } else if (current_style.start_index > end_index) {
-            current_style.start_index -= (end_index + 1) - start_index;
-            current_style.end_index -= (end_index + 1) - start_index;
-            current_style.index_dirty = true;
-            current_style.text_dirty = true;
-        }
-    }
-    m_text_line.remove(start_index, m_width);
+    m_cells.remove(start_index, std::min(m_width, m_cells.size() - start_index));
+    markAllDirty();
 }
 
 void Block::moveLinesFromBlock(Block *block, int start_line, int count)
@@ -439,30 +298,17 @@ void Block::moveLinesFromBlock(Block *block, int start_line, int count)
     Q_ASSERT(block->lineCount() >= start_line + count);
 
     int start_char = block->width() * start_line;
-    int end_char = (block->width() * (start_line + count)) - 1;
-
-    for (int i = 0; i < block->m_style_list.size(); i++) {
-        TextStyleLine &current_style = block->m_style_list[i];
-        if (current_style.start_index >= start_char && current_style.end_index <= end_char) {
-            current_style.start_index += (-start_char + m_text_line.size());
-            current_style.end_index += (-start_char + m_text_line.size());
-            current_style.releaseTextSegment(m_screen);
-            m_style_list.append(TextStyleLine(current_style, current_style.start_index,
-                        current_style.end_index));
-            block->m_style_list.remove(i);
-            i--;
-        } else if (current_style.start_index > end_char) {
-            current_style.start_index -= (end_char + 1) - start_char;
-            current_style.end_index -= (end_char + 1) - start_char;
-            current_style.index_dirty = true;
-            current_style.text_dirty = true;
-        }
-    }
+    int end_char = std::min(block->width() * (start_line + count), block->m_cells.size()) - 1;
+    const int size = (end_char + 1) - start_char;
 
-    m_text_line.append(block->m_text_line.mid(start_char, (end_char + 1) - start_char));
-    block->m_text_line.remove(start_char, (end_char + 1) - start_char);
-    m_changed = true;
-    block->m_changed = true;
+    const int old_size = m_cells.size();
+    m_cells.resize(old_size + size);
+    memcpy(m_cells.data() + old_size, block->m_cells.constData() + start_char, size * sizeof(TextCell));
+    m_only_latin = m_only_latin && block->m_only_latin;
+
+    block->m_cells.remove(start_char, size);
+    markDirty(old_size, m_cells.size() - 1);
+    block->markAllDirty();
 }
 
 void Block::dispatchEvents()
@@ -471,10 +317,17 @@ void Block::dispatchEvents()
         return;
     }
 
-    mergeCompatibleStyles();
+    if (BlockRenderer *renderer = m_screen->blockRenderer()) {
+        renderer->blockChanged(this, m_new_line, m_width, m_cells.constData(), m_cells.size());
+        m_changed = false;
+        m_line = m_new_line;
+        return;
+    }
+
+    syncTextLine();
+    updateStyleList();
 
     for (int i = 0; i < m_style_list.size(); i++) {
-        ensureStyleAlignWithLines(i);
         TextStyleLine &current_style = m_style_list[i];
          if (current_style.text_segment == 0) {
              current_style.text_segment = m_screen->createTextSegment(current_style);
@@ -484,7 +337,7 @@ void Block::dispatchEvents()
          }
 
         if (current_style.style_dirty) {
-            current_style.text_segment->setTextStyle(current_style);
+            current_style.text_segment->setTextStyle(current_style.style_id);
             current_style.style_dirty = false;
         }
 
@@ -506,6 +359,8 @@ void Block::dispatchEvents()
 void Block::releaseTextObjects()
 {
     m_changed = true;
+    if (BlockRenderer *renderer = m_screen->blockRenderer())
+        renderer->blockReleased(this);
     for (int i = 0; i < m_style_list.size(); i++) {
         TextStyleLine &currentStyleLine = m_style_list[i];
         currentStyleLine.releaseTextSegment(m_screen);
@@ -514,9 +369,54 @@ void Block::releaseTextObjects()
     }
 }
 
+void Block::markLiveStyles(QBitArray *live) const
+{
+    for (const TextCell &cell : m_cells)
+        live->setBit(cell.style);
+    for (const TextStyleLine &line : m_style_list)
+        live->setBit(line.style_id);
+}
+
+void Block::markLiveClusters(QBitArray *live) const
+{
+    if (m_only_latin)
+        return;
+    for (const TextCell &cell : m_cells) {
+        if (ClusterTable::isCluster(cell.character))
+            ClusterTable::markLive(live, cell.character);
+    }
+}
+
+// Frees everything that is only needed to show the block, along with the
+// spare capacity of the cells. It is all rebuilt on the next dispatch.
+void Block::compact()
+{
+    releaseTextObjects();
+    m_style_list = QVector<TextStyleLine>();
+    m_style_list_dirty = true;
+    m_text_line = QString();
+    m_text_dirty_from = INT_MAX;
+    m_dirty_lines = QBitArray();
+    m_cells.squeeze();
+}
+
+// The runs of cells with the same style, without splitting them where the
+// block wraps. The list used for the text segments is built in
+// updateStyleList().
 QVector<TextStyleLine> Block::style_list()
 {
-    return m_style_list;
+    const TextStyleTable &styles = m_screen->styleTable();
+    QVector<TextStyleLine> runs;
+    const int size = m_cells.size();
+    for (int start = 0; start < size;) {
+        const quint16 id = m_cells.at(start).style;
+        int end = start;
+        while (end + 1 < size && m_cells.at(end + 1).style == id)
+            end++;
+        runs.append(TextStyleLine(styles.style(id), start, end, id));
+        start = end + 1;
+    }
+    return runs;
 }
 
 void Block::printStyleList() const
@@ -527,8 +427,8 @@ void Block::printStyleList() const
 
 void Block::printStyleList(QDebug &debug) const
 {
-    QString text_line = m_text_line;
-    debug << "  " << m_line << lineCount() << m_text_line.size() << (void *) this << text_line << "\n"; debug << "\t";
+    QString text_line = textLine();
+    debug << "  " << m_line << lineCount() << text_line.size() << (void *) this << text_line << "\n"; debug << "\t";
     for (int i= 0; i < m_style_list.size(); i++) {
         debug << m_style_list.at(i);
     }
@@ -536,38 +436,119 @@ void Block::printStyleList(QDebug &debug) const
 
 void Block::printStyleListWidthText() const
 {
-    QString text_line = m_text_line;
+    QString text_line = textLine();
     for (int i= 0; i < m_style_list.size(); i++) {
         const TextStyleLine &currentStyle = m_style_list.at(i);
         QDebug debug = qDebug();
-        debug << m_text_line.mid(currentStyle.start_index, (currentStyle.end_index + 1) - currentStyle.start_index) << currentStyle;
+        debug << text_line.mid(currentStyle.start_index, (currentStyle.end_index + 1) - currentStyle.start_index) << currentStyle;
     }
 }
 
-void Block::mergeCompatibleStyles()
+void Block::fillCells(int from, const QString &text, quint16 style)
 {
-    for (int i = 1; i < m_style_list.size(); i++) {
-        TextStyleLine &current = m_style_list[i];
-        if (m_style_list.at(i - 1).isCompatible(current) &&
-                current.start_index % m_width) {
-            TextStyleLine &prev = m_style_list[i-1];
-            prev.end_index = current.end_index;
-            prev.text_dirty = true;
-            current.releaseTextSegment(m_screen);
-            m_style_list.remove(i);
-            i--;
-        }
+    const QChar *src = text.constData();
+    TextCell *dst = m_cells.data() + from;
+    for (int i = 0; i < text.size(); i++) {
+        dst[i].character = src[i];
+        dst[i].style = style;
     }
 }
 
-void Block::ensureStyleAlignWithLines(int i)
+// Cells that are written over or moved apart can leave one half of a wide
+// character behind. Both halves are blanked, as xterm does, so the padding
+// cell does not end up next to a different character.
+void Block::breakWideCharacter(int pos)
 {
-    int start_line = m_style_list[i].start_index / m_width;
-    int end_line = m_style_list[i].end_index / m_width;
-    if (start_line != end_line) {
-        int remainder_start_line = ((m_width * (start_line + 1))-1) - m_style_list[i].start_index;
-        int next_line_end_index = m_style_list[i].end_index;
-        m_style_list[i].end_index = m_style_list[i].start_index + remainder_start_line;
-        m_style_list.insert(i + 1, TextStyleLine(m_style_list[i], m_style_list[i].end_index + 1, next_line_end_index));
+    if (pos <= 0 || pos >= m_cells.size() || !CharWidth::isPadding(m_cells.at(pos).character))
+        return;
+    m_cells[pos - 1].character = QChar(' ');
+    m_cells[pos].character = QChar(' ');
+    markDirty(pos - 1, pos);
+}
+
+void Block::markDirty(int from, int to)
+{
+    m_changed = true;
+    m_style_list_dirty = true;
+    m_text_dirty_from = std::min(m_text_dirty_from, from);
+
+    if (to < from)
+        return;
+    const int first_line = from / m_width;
+    const int last_line = to / m_width;
+    if (last_line >= m_dirty_lines.size())
+        m_dirty_lines.resize(last_line + 1);
+    m_dirty_lines.fill(true, first_line, last_line + 1);
+}
+
+void Block::markAllDirty()
+{
+    markDirty(0, m_cells.size() - 1);
+}
+
+void Block::syncTextLine() const
+{
+    if (m_text_line.size() != m_cells.size()) {
+        m_text_dirty_from = std::min(m_text_dirty_from, m_text_line.size());
+        m_text_line.resize(m_cells.size());
+    }
+    if (m_text_dirty_from >= m_cells.size()) {
+        m_text_dirty_from = INT_MAX;
+        return;
+    }
+
+    const TextCell *src = m_cells.constData();
+    QChar *dst = m_text_line.data();
+    for (int i = m_text_dirty_from; i < m_cells.size(); i++)
+        dst[i] = src[i].character;
+    m_text_dirty_from = INT_MAX;
+}
+
+// Turns the cells back into runs of the same style, split where the block
+// wraps to a new line. The existing entries are reused in order, so their
+// text segments follow along, and only the runs that changed are flagged for
+// the next dispatch.
+void Block::updateStyleList()
+{
+    if (!m_style_list_dirty)
+        return;
+
+    const TextStyleTable &styles = m_screen->styleTable();
+    const int size = m_cells.size();
+    int run = 0;
+    for (int start = 0; start < size; run++) {
+        const quint16 id = m_cells.at(start).style;
+        const int line_end = std::min(size, ((start / m_width) + 1) * m_width) - 1;
+        int end = start;
+        while (end < line_end && m_cells.at(end + 1).style == id)
+            end++;
+
+        if (run < m_style_list.size()) {
+            TextStyleLine &current_style = m_style_list[run];
+            if (current_style.style_id != id) {
+                current_style.setStyle(styles.style(id));
+                current_style.style_id = id;
+                current_style.style_dirty = true;
+            }
+            if (current_style.start_index != start || current_style.end_index != end) {
+                current_style.start_index = start;
+                current_style.end_index = end;
+                current_style.index_dirty = true;
+                current_style.text_dirty = true;
+            } else if (start / m_width < m_dirty_lines.size() && m_dirty_lines.testBit(start / m_width)) {
+                current_style.text_dirty = true;
+            }
+        } else {
+            m_style_list.append(TextStyleLine(styles.style(id), start, end, id));
+        }
+        start = end + 1;
     }
+
+    for (int i = run; i < m_style_list.size(); i++) {
+        m_style_list[i].releaseTextSegment(m_screen);
+    }
+    m_style_list.resize(run);
+
+    m_dirty_lines.fill(false);
+    m_style_list_dirty = false;
 }
@@ -25,12 +25,26 @@
 #define BLOCK_H
 
 #include <QtCore/QObject>
+#include <QtCore/QVector>
+#include <QtCore/QBitArray>
 
 #include "text_style.h"
 
 class Text;
 class Screen;
 
+// One character position in a Block. style is an id from the Screen's
+// TextStyleTable, so a cell fits in four bytes and rows can be moved with
+// memmove.
+// character is a UTF-16 unit, so cell indexes line up with QString indexes;
+// characters that need more than one are kept in the Screen's ClusterTable.
+struct TextCell
+{
+    QChar character;
+    quint16 style;
+};
+Q_DECLARE_TYPEINFO(TextCell, Q_PRIMITIVE_TYPE);
+
 class Block
 {
 public:
@@ -47,7 +61,9 @@ public:
     void deleteLines(int from);
 
     void replaceAtPos(int i, const QString &text, const TextStyle &style, bool only_latin = true);
+    void replaceAtPos(int i, const QString &text, quint16 style, bool only_latin = true);
     void insertAtPos(int i, const QString &text, const TextStyle &style, bool only_latin = true);
+    void insertAtPos(int i, const QString &text, quint16 style, bool only_latin = true);
 
     void setScreenIndex(int index) { m_screen_index = index; }
     int screenIndex() const { return m_screen_index; }
@@ -60,14 +76,19 @@ public:
     }
 
     QString textLine() const;
-    int textSize() { return m_text_line.size(); }
+    void appendText(QString *out, int from, int to) const;
+    int textSize() { return m_cells.size(); }
+    const QVector<TextCell> &cells() const { return m_cells; }
+    bool onlyLatin() const { return m_only_latin; }
+    void setCells(const QVector<TextCell> &cells, bool only_latin);
+    void attachToCell(int pos, const QString &text);
 
     int width() const { return m_width; }
     void setWidth(int width);
-    int lineCount() const { return (std::max((m_text_line.size() - 1),0) / m_width) + 1; }
+    int lineCount() const { return (std::max((m_cells.size() - 1),0) / m_width) + 1; }
     int lineCountAfterModified(int from_char, int text_size, bool replace) {
-        int new_size = replace ? std::max(from_char + text_size, m_text_line.size())
-            : std::max(from_char, m_text_line.size()) + text_size;
+        int new_size = replace ? std::max(from_char + text_size, m_cells.size())
+            : std::max(from_char, m_cells.size()) + text_size;
         return ((new_size - 1) / m_width) + 1;
     }
 
@@ -82,6 +103,9 @@ public:
 
     void dispatchEvents();
     void releaseTextObjects();
+    void markLiveStyles(QBitArray *live) const;
+    void markLiveClusters(QBitArray *live) const;
+    void compact();
 
     QVector<TextStyleLine> style_list();
 
@@ -90,11 +114,23 @@ public:
     void printStyleListWidthText() const;
 
 private:
-    void mergeCompatibleStyles();
-    void ensureStyleAlignWithLines(int i);
+    void fillCells(int from, const QString &text, quint16 style);
+    void breakWideCharacter(int pos);
+    void markDirty(int from, int to);
+    void markAllDirty();
+    void syncTextLine() const;
+    void updateStyleList();
+
     Screen *m_screen;
-    QString m_text_line;
+    QVector<TextCell> m_cells;
+    // The text is materialized from the cells when somebody asks for it. The
+    // Text objects keep a pointer to it, so it has to live as long as the Block.
+    mutable QString m_text_line;
+    mutable int m_text_dirty_from;
+    // Per line dirty bits, used to decide which style runs need new text.
+    QBitArray m_dirty_lines;
     QVector<TextStyleLine> m_style_list;
+    bool m_style_list_dirty;
     size_t m_line;
     size_t m_new_line;
     int m_screen_index;
@@ -0,0 +1,47 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef BLOCK_RENDERER_H
+#define BLOCK_RENDERER_H
+
+#include <stddef.h>
+
+class Block;
+struct TextCell;
+
+// Takes over drawing the blocks of a Screen from the Text objects that Block
+// otherwise creates for each of its style runs. The calls follow the life of
+// those Text objects: a block is announced when it is dispatched with
+// changes, and released when it leaves the screen or is deleted.
+class BlockRenderer
+{
+public:
+    virtual ~BlockRenderer() {}
+
+    // line is the content line of the first row of the block. cells is only
+    // valid for the duration of the call.
+    virtual void blockChanged(const Block *block, size_t line, int width, const TextCell *cells, int size) = 0;
+    virtual void blockReleased(const Block *block) = 0;
+};
+
+#endif // BLOCK_RENDERER_H
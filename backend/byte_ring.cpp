@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "byte_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+ByteRing::ByteRing(int capacity)
+    : m_write_pos(0)
+    , m_read_pos(0)
+{
+    size_t size = 1;
+    while (size < size_t(capacity))
+        size <<= 1;
+    m_data = new char[size];
+    m_mask = size - 1;
+}
+
+ByteRing::~ByteRing()
+{
+    delete[] m_data;
+}
+
+char *ByteRing::writeBuffer(int *size)
+{
+    const size_t write_pos = m_write_pos.load(std::memory_order_relaxed);
+    const size_t used = write_pos - m_read_pos.load(std::memory_order_acquire);
+    const size_t offset = write_pos & m_mask;
+    *size = int(std::min(m_mask + 1 - used, m_mask + 1 - offset));
+    return m_data + offset;
+}
+
+void ByteRing::commitWrite(int size)
+{
+    m_write_pos.store(m_write_pos.load(std::memory_order_relaxed) + size, std::memory_order_release);
+}
+
+int ByteRing::readAll(QByteArray *data)
+{
+    const size_t read_pos = m_read_pos.load(std::memory_order_relaxed);
+    const size_t size = m_write_pos.load(std::memory_order_acquire) - read_pos;
+    if (!size)
+        return 0;
+
+    const size_t offset = read_pos & m_mask;
+    const size_t first = std::min(size, m_mask + 1 - offset);
+    data->append(m_data + offset, int(first));
+    if (first < size)
+        data->append(m_data, int(size - first));
+
+    m_read_pos.store(read_pos + size, std::memory_order_release);
+    return int(size);
+}
+
+int ByteRing::available() const
+{
+    return int(m_write_pos.load(std::memory_order_acquire) - m_read_pos.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef BYTE_RING_H
+#define BYTE_RING_H
+
+#include <QtCore/QByteArray>
+
+#include <atomic>
+#include <stddef.h>
+
+// A fixed size byte queue between exactly one writing and one reading
+// thread, without locks. The capacity is rounded up to a power of two.
+class ByteRing
+{
+public:
+    explicit ByteRing(int capacity);
+    ~ByteRing();
+
+    int capacity() const { return int(m_mask + 1); }
+
+    // Writer side. Returns the contiguous free space at the write end in
+    // size, to be filled in place and then published with commitWrite().
+    char *writeBuffer(int *size);
+    void commitWrite(int size);
+
+    // Reader side. Appends everything available to data and returns how many
+    // bytes that was.
+    int readAll(QByteArray *data);
+    int available() const;
+
+private:
+    Q_DISABLE_COPY(ByteRing)
+
+    char *m_data;
+    size_t m_mask;
+    // Both only ever grow; the difference is the number of queued bytes.
+    std::atomic<size_t> m_write_pos;
+    std::atomic<size_t> m_read_pos;
+};
+
+#endif // BYTE_RING_H
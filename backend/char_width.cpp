@@ -0,0 +1,222 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "char_width.h"
+#include "char_width_table.h"
+#include "screen.h"
+
+#include <QtCore/QLoggingCategory>
+
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(lcCharWidth, "yat.charwidth", QtWarningMsg)
+
+// Looking for live clusters walks the screen and scrollback, so while nearly
+// all ids are in use it is only done once per this many reserve() calls.
+static const int reclaimInterval = 64;
+
+ClusterTable::ClusterTable(Screen *screen)
+    : m_screen(screen)
+    , m_reclaim_delay(0)
+{
+}
+
+void ClusterTable::reserve(int count)
+{
+    if (maxClusters - size() >= count)
+        return;
+    if (m_reclaim_delay > 0) {
+        m_reclaim_delay--;
+        return;
+    }
+    reclaim();
+    m_reclaim_delay = maxClusters - size() < count ? reclaimInterval : 0;
+}
+
+QChar ClusterTable::intern(const QString &text)
+{
+    auto it = m_ids.constFind(text);
+    if (it != m_ids.constEnd())
+        return QChar(it.value());
+
+    ushort id;
+    if (!m_free.isEmpty()) {
+        id = m_free.takeLast();
+        m_clusters[id - firstId] = text;
+    } else if (m_clusters.size() < maxClusters) {
+        id = ushort(firstId + m_clusters.size());
+        m_clusters.append(text);
+    } else {
+        return QChar(QChar::ReplacementCharacter);
+    }
+    m_ids.insert(text, id);
+    return QChar(id);
+}
+
+void ClusterTable::appendText(QString *out, const QChar *characters, int count) const
+{
+    for (int i = 0; i < count; i++) {
+        if (isCluster(characters[i]))
+            out->append(text(characters[i]));
+        else
+            out->append(characters[i]);
+    }
+}
+
+void ClusterTable::markLive(QBitArray *live, QChar character)
+{
+    const int id = character.unicode() - firstId;
+    if (id < live->size())
+        live->setBit(id);
+}
+
+void ClusterTable::reclaim()
+{
+    QBitArray live(m_clusters.size());
+    m_screen->markLiveClusters(&live);
+
+    m_free.clear();
+    for (int i = m_clusters.size() - 1; i >= 0; i--) {
+        if (live.testBit(i))
+            continue;
+        const ushort id = ushort(firstId + i);
+        auto it = m_ids.find(m_clusters.at(i));
+        if (it != m_ids.end() && it.value() == id)
+            m_ids.erase(it);
+        m_clusters[i] = QString();
+        m_free.append(id);
+    }
+    qCDebug(lcCharWidth) << "Reclaimed" << m_free.size() << "clusters";
+}
+
+namespace CharWidth {
+
+int width(uint code_point)
+{
+    if (code_point >= sizeof(char_width_stage1) << char_width_block_bits)
+        return 1;
+    const int block = char_width_stage1[code_point >> char_width_block_bits];
+    const int offset = (code_point & ((1 << char_width_block_bits) - 1)) >> 2;
+    const int shift = (code_point & 3) * 2;
+    return (char_width_stage2[(block << (char_width_block_bits - 2)) + offset] >> shift) & 3;
+}
+
+static uint codePointAt(const QString &text, int i, int *units)
+{
+    const QChar c = text.at(i);
+    if (c.isHighSurrogate() && i + 1 < text.size() && text.at(i + 1).isLowSurrogate()) {
+        *units = 2;
+        return QChar::surrogateToUcs4(c, text.at(i + 1));
+    }
+    *units = 1;
+    return c.unicode();
+}
+
+// Unpaired surrogates have no width of their own, but they are not attached
+// to anything either; they end up as U+FFFD.
+static bool isZeroWidth(uint code_point)
+{
+    return !QChar::isSurrogate(code_point) && CharWidth::width(code_point) == 0;
+}
+
+QChar cell(const QString &text, ClusterTable *clusters, int *columns)
+{
+    int units;
+    const uint base = codePointAt(text, 0, &units);
+    *columns = std::max(CharWidth::width(base), 1);
+    if (text.size() == 1)
+        return text.at(0).isSurrogate() ? QChar(QChar::ReplacementCharacter) : text.at(0);
+
+    const QString composed = text.normalized(QString::NormalizationForm_C);
+    if (composed.size() == 1 && !composed.at(0).isSurrogate()) {
+        *columns = std::max(CharWidth::width(composed.at(0).unicode()), 1);
+        return composed.at(0);
+    }
+    return clusters->intern(composed);
+}
+
+bool layout(const QString &text, int column, int width, ClusterTable *clusters, QString *out, QString *leading)
+{
+    // Most text only has characters that take one cell, and then nothing
+    // needs to be copied.
+    int first_changed = 0;
+    for (; first_changed < text.size(); first_changed++) {
+        const QChar c = text.at(first_changed);
+        if (c.isSurrogate() || CharWidth::width(c.unicode()) != 1)
+            break;
+    }
+    if (first_changed == text.size())
+        return false;
+
+    // Every cluster has a character outside the BMP or a zero width one.
+    int cluster_count = 0;
+    for (int i = first_changed, units; i < text.size(); i += units) {
+        const uint code_point = codePointAt(text, i, &units);
+        if (units == 2 || isZeroWidth(code_point))
+            cluster_count++;
+    }
+    clusters->reserve(cluster_count);
+
+    // The character before the first one that changes may have zero width
+    // characters attached.
+    const int start = std::max(first_changed - 1, 0);
+    out->resize(0);
+    out->reserve(text.size() * 2);
+    out->append(text.constData(), start);
+    leading->resize(0);
+    int col = column + start;
+    QString pending;
+    auto flush = [&]() {
+        if (pending.isEmpty())
+            return;
+        int w;
+        const QChar c = cell(pending, clusters, &w);
+        pending.resize(0);
+        if (w == 2 && width > 1 && col % width == width - 1) {
+            out->append(QChar(' '));
+            col++;
+        }
+        out->append(c);
+        col++;
+        if (w == 2) {
+            out->append(QChar(padding));
+            col++;
+        }
+    };
+    for (int i = start, units; i < text.size(); i += units) {
+        const uint code_point = codePointAt(text, i, &units);
+        if (isZeroWidth(code_point)) {
+            if (pending.isEmpty())
+                leading->append(text.constData() + i, units);
+            else
+                pending.append(text.constData() + i, units);
+            continue;
+        }
+        flush();
+        pending.append(text.constData() + i, units);
+    }
+    flush();
+    return true;
+}
+
+}
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef CHAR_WIDTH_H
+#define CHAR_WIDTH_H
+
+#include <QtCore/QBitArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+class Screen;
+
+// A cell holds a single UTF-16 unit. Characters outside the BMP, and
+// characters with zero width characters attached to them, are kept in the
+// Screen's ClusterTable instead, and the cell holds an id from the surrogate
+// range, which cells never hold otherwise. Once the ids run out, the ones no
+// cell uses any more are handed out again.
+class ClusterTable
+{
+public:
+    ClusterTable(Screen *screen);
+
+    static bool isCluster(QChar character) { return character.isSurrogate(); }
+
+    // Makes room for count more clusters, if the ones that are no longer
+    // used allow it. Nothing is reclaimed in intern(), so text that is laid
+    // out but not yet written keeps its ids.
+    void reserve(int count);
+    // U+FFFD when there is no room left.
+    QChar intern(const QString &text);
+    const QString &text(QChar character) const { return m_clusters.at(character.unicode() - firstId); }
+    // Appends characters, with the text of the clusters among them.
+    void appendText(QString *out, const QChar *characters, int count) const;
+    int size() const { return m_clusters.size() - m_free.size(); }
+
+    // Sets the bit of a cluster in a QBitArray with a bit per id.
+    static void markLive(QBitArray *live, QChar character);
+
+private:
+    static const ushort firstId = 0xd800;
+    static const int maxClusters = 0xe000 - 0xd800;
+
+    void reclaim();
+
+    Screen *m_screen;
+    QVector<QString> m_clusters;
+    QHash<QString, ushort> m_ids;
+    QVector<ushort> m_free;
+    int m_reclaim_delay;
+};
+
+// How many columns a character takes: 0 for combining marks and other
+// characters that attach to the one before them, 2 for East Asian wide and
+// fullwidth characters, and 1 for everything else.
+//
+// Every column is a cell, so a wide character is followed by a padding cell
+// to make up its second column.
+namespace CharWidth {
+
+const ushort padding = 0x200b;
+
+int width(uint code_point);
+
+inline bool isPadding(QChar character)
+{
+    return character.unicode() == padding;
+}
+
+// Lays text out in cells, starting at column of a screen that is width
+// columns wide (0 if it does not wrap). Zero width characters stay with the
+// character before them, composed with it where Unicode has a precomposed
+// form, and go in a cluster with it otherwise, as do characters outside the
+// BMP. Zero width characters at the start of text belong to the cell before
+// column, and are left in leading. Wide characters get their padding cell,
+// and one that would be split by the end of the line moves to the next one.
+// Returns false, leaving out and leading alone, when every character takes
+// a single cell and text can be used as it is.
+bool layout(const QString &text, int column, int width, ClusterTable *clusters, QString *out, QString *leading);
+
+// The cell for a character with zero width characters attached, which is
+// the composed character if there is one, or a cluster. Sets *columns to
+// the columns it takes.
+QChar cell(const QString &text, ClusterTable *clusters, int *columns);
+
+}
+
+#endif // CHAR_WIDTH_H
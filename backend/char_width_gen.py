@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+# Generates char_width_table.h, the column width of every code point, from
+# the Unicode database that comes with Python:
+#
+#   python3 char_width_gen.py > char_width_table.h
+#
+# Combining marks, format characters and Hangul medial vowels and final
+# consonants take no columns. East Asian wide and fullwidth characters, and
+# the rest of the CJK ideograph planes, take two. Everything else takes one.
+
+import unicodedata
+
+BLOCK_BITS = 7
+BLOCK_SIZE = 1 << BLOCK_BITS
+
+
+def width(cp):
+    if cp == 0x00ad:
+        return 1
+    if 0x1160 <= cp <= 0x11ff or 0xd7b0 <= cp <= 0xd7ff or cp == 0x200b:
+        return 0
+    c = chr(cp)
+    category = unicodedata.category(c)
+    if category in ('Mn', 'Me'):
+        return 0
+    if category == 'Cf' and not (0x0600 <= cp <= 0x0605 or cp in (0x06dd, 0x070f, 0x08e2, 0x110bd, 0x110cd)):
+        return 0
+    if unicodedata.east_asian_width(c) in ('W', 'F'):
+        return 2
+    if 0x20000 <= cp <= 0x2fffd or 0x30000 <= cp <= 0x3fffd:
+        return 2
+    return 1
+
+
+def main():
+    blocks = {}
+    stage1 = []
+    stage2 = []
+    for start in range(0, 0x110000, BLOCK_SIZE):
+        packed = []
+        for i in range(start, start + BLOCK_SIZE, 4):
+            byte = 0
+            for j in range(4):
+                byte |= width(i + j) << (j * 2)
+            packed.append(byte)
+        packed = tuple(packed)
+        if packed not in blocks:
+            blocks[packed] = len(blocks)
+            stage2.extend(packed)
+        stage1.append(blocks[packed])
+    assert len(blocks) < 256
+
+    print('// Generated by char_width_gen.py from Unicode %s, do not edit.' % unicodedata.unidata_version)
+    print('//')
+    print('// char_width_stage1 has the block of every %d code points, and each block' % BLOCK_SIZE)
+    print('// in char_width_stage2 holds their widths, two bits each.')
+    print()
+    print('#ifndef CHAR_WIDTH_TABLE_H')
+    print('#define CHAR_WIDTH_TABLE_H')
+    print()
+    print('static const int char_width_block_bits = %d;' % BLOCK_BITS)
+    print()
+    for name, values in (('char_width_stage1', stage1), ('char_width_stage2', stage2)):
+        print('static const unsigned char %s[] = {' % name)
+        for i in range(0, len(values), 16):
+            print('    ' + ','.join('%d' % v for v in values[i:i + 16]) + ',')
+        print('};')
+        print()
+    print('#endif // CHAR_WIDTH_TABLE_H')
+
+
+if __name__ == '__main__':
+    main()
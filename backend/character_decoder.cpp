@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "character_decoder.h"
+#include "character_sets.h"
+
+static const ushort *tableForCharacterSet(CharacterSet::CharacterSet characterSet)
+{
+    switch (characterSet) {
+    case CharacterSet::dec_special_graphics:
+        return dec_special_graphics_char_set;
+    case CharacterSet::nrc_british:
+        return nrc_british_char_set;
+    case CharacterSet::nrc_norwegian_danish:
+        return nrc_norwegian_danish_char_set;
+    case CharacterSet::nrc_dutch:
+        return nrc_dutch_char_set;
+    case CharacterSet::nrc_finnish:
+        return nrc_finnish_char_set;
+    case CharacterSet::nrc_french:
+        return nrc_french_char_set;
+    case CharacterSet::nrc_french_canadian:
+        return nrc_french_canadian_char_set;
+    case CharacterSet::nrc_german:
+        return nrc_german_char_set;
+    case CharacterSet::nrc_italian:
+        return nrc_italian_char_set;
+    case CharacterSet::nrc_spanish:
+        return nrc_spanish_char_set;
+    case CharacterSet::nrc_swedish:
+        return nrc_swedish_char_set;
+    case CharacterSet::nrc_swiss:
+        return nrc_swiss_char_set;
+    default:
+        return 0;
+    }
+}
+
+CharacterDecoder::CharacterDecoder()
+    : m_character_set(CharacterSet::utf_8)
+    , m_table(0)
+{
+    reset();
+}
+
+void CharacterDecoder::setCharacterSet(CharacterSet::CharacterSet characterSet)
+{
+    m_character_set = characterSet;
+    m_table = tableForCharacterSet(characterSet);
+}
+
+void CharacterDecoder::reset()
+{
+    m_utf8.clear();
+}
+
+void CharacterDecoder::decode(const char *data, int size, QString *out)
+{
+    // A byte never produces more than one UTF-16 unit, except for the last
+    // byte of a split four byte sequence (two units) and a byte that
+    // interrupts a pending sequence (a replacement character and itself).
+    out->resize(size + 2);
+    ushort *dst = reinterpret_cast<ushort *>(out->data());
+    ushort *const start = dst;
+    const uchar *src = reinterpret_cast<const uchar *>(data);
+    const uchar *const end = src + size;
+
+    if (m_character_set == CharacterSet::latin_1) {
+        while (src < end)
+            *dst++ = *src++;
+        out->resize(int(dst - start));
+        return;
+    }
+
+    auto emit = [this, &dst](char32_t code_point) {
+        if (code_point < 0x80) {
+            if (m_table && code_point > 0x20 && code_point < 0x7f && m_table[code_point - 0x21])
+                *dst++ = m_table[code_point - 0x21];
+            else
+                *dst++ = ushort(code_point);
+        } else if (code_point > 0xffff) {
+            *dst++ = QChar::highSurrogate(code_point);
+            *dst++ = QChar::lowSurrogate(code_point);
+        } else {
+            *dst++ = ushort(code_point);
+        }
+    };
+
+    while (src < end) {
+        const uchar c = *src++;
+        if (c < 0x80 && !m_utf8.isPending())
+            emit(c);
+        else
+            m_utf8.feed(c, emit);
+    }
+
+    out->resize(int(dst - start));
+}
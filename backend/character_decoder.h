@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef CHARACTER_DECODER_H
+#define CHARACTER_DECODER_H
+
+#include "utf8_decoder.h"
+
+#include <QtCore/QString>
+
+namespace CharacterSet {
+enum CharacterSet {
+    utf_8,
+    ascii,
+    latin_1,
+    dec_special_graphics,
+    nrc_british,
+    nrc_norwegian_danish,
+    nrc_dutch,
+    nrc_finnish,
+    nrc_french,
+    nrc_french_canadian,
+    nrc_german,
+    nrc_italian,
+    nrc_spanish,
+    nrc_swedish,
+    nrc_swiss
+};
+}
+
+// Turns the bytes of a text run into UTF-16 in a single pass. UTF-8 is
+// validated as it goes (invalid sequences become U+FFFD), and the state of a
+// sequence that is split over two runs is kept until the next call. When a
+// national replacement or DEC graphics set is selected, the 94 graphic
+// characters are looked up in its table instead.
+class CharacterDecoder
+{
+public:
+    CharacterDecoder();
+
+    CharacterSet::CharacterSet characterSet() const { return m_character_set; }
+    void setCharacterSet(CharacterSet::CharacterSet characterSet);
+
+    // Replaces the contents of out with the decoded text. out is only
+    // resized, so a buffer that is reused between calls does not allocate.
+    void decode(const char *data, int size, QString *out);
+    void reset();
+
+private:
+    CharacterSet::CharacterSet m_character_set;
+    const ushort *m_table;
+    Utf8Decoder m_utf8;
+};
+
+#endif // CHARACTER_DECODER_H
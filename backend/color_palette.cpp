@@ -275,6 +275,7 @@ ColorPalette::ColorPalette(QObject *parent)
     m_lightColors[8].setRgb(220,220,220);
     m_lightColors[9].setRgb(50,50,50);
 
+    updateRgbTables();
 }
 
 QColor ColorPalette::color(ColorPalette::Color color, bool bold) const
@@ -317,6 +318,7 @@ void ColorPalette::setInverseDefaultColors(bool inverse)
     bool emit_changed = inverse != m_inverse_default;
     if (emit_changed) {
         m_inverse_default = inverse;
+        updateRgbTables();
         emit changed();
         emit defaultBackgroundColorChanged();
     }
@@ -331,3 +333,15 @@ QColor ColorPalette::defaultBackground() const
 {
     return normalColor(DefaultBackground);
 }
+
+void ColorPalette::updateRgbTables()
+{
+    for (int i = 0; i < 8; i++) {
+        m_indexed_rgb[i] = color(Color(i), false).rgb();
+        m_indexed_rgb[i + 8] = color(Color(i), true).rgb();
+    }
+    for (int i = 16; i < 256; i++)
+        m_indexed_rgb[i] = m_xtermColors.at(i - 16);
+    m_default_rgb[0] = defaultForeground().rgb();
+    m_default_rgb[1] = defaultBackground().rgb();
+}
@@ -40,14 +40,24 @@ public:
 
     QColor defaultForeground() const;
     QColor defaultBackground() const;
+
+    // Flat lookups for applying SGR colors. Indexes 0-7 are the normal
+    // colors, 8-15 the light ones and the rest the xterm colors.
+    QRgb indexedRgb(int index) const { return m_indexed_rgb[index]; }
+    QRgb defaultForegroundRgb() const { return m_default_rgb[0]; }
+    QRgb defaultBackgroundRgb() const { return m_default_rgb[1]; }
 signals:
     void changed();
     void defaultBackgroundColorChanged();
 
 private:
+    void updateRgbTables();
+
     QVector<QColor> m_normalColors;
     QVector<QColor> m_lightColors;
     QVector<QRgb> m_xtermColors;
+    QRgb m_indexed_rgb[256];
+    QRgb m_default_rgb[2];
 
     bool m_inverse_default;
 };
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef CSI_PARAMETERS_H
+#define CSI_PARAMETERS_H
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+
+#include <limits.h>
+
+// The numeric parameters of a control sequence. Digits are accumulated into
+// the value being parsed and finished values go into a fixed array, so
+// parsing a sequence never allocates. Values after a ':' are sub-parameters
+// of the value before them, as in "38:2::255:128:0". Parameters past the
+// capacity are dropped.
+class CsiParameters
+{
+public:
+    enum { Capacity = 32 };
+    // An empty parameter, to be replaced by the default of the sequence.
+    static const int Default = INT_MIN;
+
+    CsiParameters()
+        : m_size(0)
+        , m_pending(-1)
+        , m_sub_parameters(0)
+        , m_next_is_sub(false)
+    { }
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return !m_size; }
+    int at(int i) const { Q_ASSERT(i >= 0 && i < m_size); return m_values[i]; }
+    bool isSubParameter(int i) const { return m_sub_parameters & (1u << i); }
+    bool hasSubParameters() const { return m_sub_parameters; }
+
+    void append(int value)
+    {
+        if (m_size == Capacity) {
+            m_next_is_sub = false;
+            return;
+        }
+        if (m_next_is_sub)
+            m_sub_parameters |= 1u << m_size;
+        m_next_is_sub = false;
+        m_values[m_size++] = value;
+    }
+    CsiParameters &operator<<(int value) { append(value); return *this; }
+    void replace(int i, int value) { Q_ASSERT(i >= 0 && i < m_size); m_values[i] = value; }
+
+    // The value being parsed, digit by digit. Saturates instead of
+    // wrapping around.
+    bool hasPendingDigits() const { return m_pending >= 0; }
+    void addDigit(int digit)
+    {
+        m_pending = m_pending < 0 ? digit : std::min(m_pending * 10 + digit, int(USHRT_MAX));
+    }
+    // Appends the value being parsed, if there is one.
+    bool finishPending()
+    {
+        if (m_pending < 0)
+            return false;
+        append(m_pending);
+        m_pending = -1;
+        return true;
+    }
+    // The next value is a sub-parameter of the last one.
+    void startSubParameter() { m_next_is_sub = true; }
+
+    void clear()
+    {
+        m_size = 0;
+        m_pending = -1;
+        m_sub_parameters = 0;
+        m_next_is_sub = false;
+    }
+
+private:
+    int m_values[Capacity];
+    int m_size;
+    int m_pending;
+    quint32 m_sub_parameters;
+    bool m_next_is_sub;
+};
+
+inline QDebug operator<<(QDebug debug, const CsiParameters &parameters)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << "CsiParameters(";
+    for (int i = 0; i < parameters.size(); i++) {
+        if (i)
+            debug << (parameters.isSubParameter(i) ? ":" : ";");
+        debug << parameters.at(i);
+    }
+    debug << ")";
+    return debug;
+}
+
+#endif // CSI_PARAMETERS_H
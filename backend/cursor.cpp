@@ -24,10 +24,10 @@
 #include "cursor.h"
 
 #include "block.h"
+#include "char_width.h"
 #include "screen_data.h"
 
 #include <QtCore/QLoggingCategory>
-#include <QTextCodec>
 
 Q_LOGGING_CATEGORY(lcCursor, "yat.cursor", QtWarningMsg)
 
@@ -35,6 +35,7 @@ Cursor::Cursor(Screen* screen)
     : QObject(screen)
     , m_screen(screen)
     , m_current_text_style(screen->defaultTextStyle())
+    , m_current_style_id(-1)
     , m_position(0,0)
     , m_new_position(0,0)
     , m_screen_width(screen->width())
@@ -59,9 +60,6 @@ Cursor::Cursor(Screen* screen)
     connect(screen, &Screen::contentHeightChanged, this, &Cursor::contentHeightChanged);
     connect(colorPalette(), &ColorPalette::changed, this, &Cursor::resetColors);
 
-    m_gl_text_codec = QTextCodec::codecForName("utf-8")->makeDecoder();
-    m_gr_text_codec = QTextCodec::codecForName("utf-8")->makeDecoder();
-
     for (int i = 0; i < m_screen_width; i++) {
         if (i % 8 == 0) {
             m_tab_stops.append(i);
@@ -176,43 +174,54 @@ void Cursor::setTextStyle(TextStyle::Style style, bool add)
     if (add) {
         m_current_text_style.style |= style;
     } else {
-        m_current_text_style.style &= !style;
+        m_current_text_style.style &= ~int(style);
     }
+    m_current_style_id = -1;
 }
 
 void Cursor::resetColors()
 {
     m_current_text_style.background = colorPalette()->defaultBackground().rgb();
     m_current_text_style.foreground = colorPalette()->defaultForeground().rgb();
+    m_current_style_id = -1;
 }
 
 void Cursor::resetStyle()
 {
     resetColors();
     m_current_text_style.style = TextStyle::Normal;
+    m_current_style_id = -1;
 }
 
 void Cursor::scrollUp(int lines)
 {
     if (new_y() < top() || new_y() > bottom())
             return;
-    for (int i = 0; i < lines; i++) {
-        screen_data()->moveLine(bottom(), top());
-    }
+    scrollRegionDown(lines);
 }
 
 void Cursor::scrollDown(int lines)
 {
     if (new_y() < top() || new_y() > bottom())
         return;
-    for (int i = 0; i < lines; i++) {
-        screen_data()->moveLine(top(), bottom());
-    }
+    scrollRegionUp(lines);
+}
+
+void Cursor::scrollRegionUp(int lines)
+{
+    lines = std::min(lines, bottom() - top() + 1);
+    screen_data()->moveLines(top(), bottom() - lines + 1, lines);
 }
 
-void Cursor::setTextCodec(QTextCodec *codec)
+void Cursor::scrollRegionDown(int lines)
 {
-    m_gl_text_codec = codec->makeDecoder();
+    lines = std::min(lines, bottom() - top() + 1);
+    screen_data()->moveLines(bottom() - lines + 1, top(), lines);
+}
+
+void Cursor::setCharacterSet(CharacterSet::CharacterSet characterSet)
+{
+    m_gl_decoder.setCharacterSet(characterSet);
 }
 
 void Cursor::setInsertMode(InsertMode mode)
@@ -225,14 +234,38 @@ TextStyle Cursor::currentTextStyle() const
     return m_current_text_style;
 }
 
+// Keeps the interned id if nothing changed.
+void Cursor::setCurrentTextStyle(const TextStyle &style)
+{
+    if (style.isCompatible(m_current_text_style))
+        return;
+    m_current_text_style = style;
+    m_current_style_id = -1;
+}
+
+quint16 Cursor::currentStyleId()
+{
+    if (m_current_style_id < 0)
+        m_current_style_id = m_screen->styleTable().intern(m_current_text_style);
+    return quint16(m_current_style_id);
+}
+
+void Cursor::markLiveStyles(QBitArray *live) const
+{
+    if (m_current_style_id >= 0)
+        live->setBit(m_current_style_id);
+}
+
 void Cursor::setTextForegroundColor(QRgb color)
 {
     m_current_text_style.foreground = color;
+    m_current_style_id = -1;
 }
 
 void Cursor::setTextBackgroundColor(QRgb color)
 {
     m_current_text_style.background = color;
+    m_current_style_id = -1;
 }
 
 void Cursor::setTextForegroundColorIndex(ColorPalette::Color color, bool bold)
@@ -474,6 +507,21 @@ void Cursor::setWrapAround(bool wrap)
     m_wrap_around = wrap;
 }
 
+// Latin-1 only has characters that take a single cell, so only other text
+// needs to be laid out by width.
+const QString &Cursor::decode_text(const QByteArray &data, bool only_latin)
+{
+    m_gl_decoder.decode(data.constData(), data.size(), &m_decode_buffer);
+    if (only_latin)
+        return m_decode_buffer;
+    const int width = m_wrap_around ? m_screen_width : 0;
+    if (!CharWidth::layout(m_decode_buffer, new_x(), width, &m_screen->clusterTable(), &m_layout_buffer, &m_leading_buffer))
+        return m_decode_buffer;
+    if (!m_leading_buffer.isEmpty())
+        screen_data()->attachToPreviousCell(m_new_position, m_leading_buffer);
+    return m_layout_buffer;
+}
+
 void Cursor::addAtCursor(const QByteArray &data, bool only_latin)
 {
     if (m_insert_mode == Replace) {
@@ -485,16 +533,16 @@ void Cursor::addAtCursor(const QByteArray &data, bool only_latin)
 
 void Cursor::replaceAtCursor(const QByteArray &data, bool only_latin)
 {
-    const QString text = m_gl_text_codec->toUnicode(data);
+    const QString &text = decode_text(data, only_latin);
 
     if (!m_wrap_around && new_x() + text.size() > m_screen->width()) {
         const int size = m_screen_width - new_x();
         QString toBlock = text.mid(0,size);
         toBlock.replace(toBlock.size() - 1, 1, text.at(text.size()-1));
-        screen_data()->replace(m_new_position, toBlock, m_current_text_style, only_latin);
+        screen_data()->replace(m_new_position, toBlock, currentStyleId(), only_latin);
         new_rx() += toBlock.size();
     } else {
-        auto diff = screen_data()->replace(m_new_position, text, m_current_text_style, only_latin);
+        auto diff = screen_data()->replace(m_new_position, text, currentStyleId(), only_latin);
         new_rx() += diff.character;
         new_ry() += diff.line;
     }
@@ -508,8 +556,8 @@ void Cursor::replaceAtCursor(const QByteArray &data, bool only_latin)
 
 void Cursor::insertAtCursor(const QByteArray &data, bool only_latin)
 {
-    const QString text = m_gl_text_codec->toUnicode(data);
-    auto diff = screen_data()->insert(m_new_position, text, m_current_text_style, only_latin);
+    const QString &text = decode_text(data, only_latin);
+    auto diff = screen_data()->insert(m_new_position, text, currentStyleId(), only_latin);
     new_rx() += diff.character;
     new_ry() += diff.line;
     if (new_y() >= m_screen_height)
@@ -518,14 +566,16 @@ void Cursor::insertAtCursor(const QByteArray &data, bool only_latin)
         new_rx() = m_screen_width - 1;
 }
 
-void Cursor::lineFeed()
+void Cursor::lineFeed(int count)
 {
-    if(new_y() >= bottom()) {
-        screen_data()->insertLine(bottom(), top());
-    } else {
-        new_ry()++;
+    if (new_y() < bottom()) {
+        const int moved = std::min(count, bottom() - new_y());
+        new_ry() += moved;
+        count -= moved;
         notifyChanged();
     }
+    if (count > 0)
+        screen_data()->insertLines(bottom(), top(), count);
 }
 
 void Cursor::reverseLineFeed()
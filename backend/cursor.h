@@ -26,6 +26,7 @@
 
 #include "text_style.h"
 #include "screen.h"
+#include "character_decoder.h"
 
 #include <QtCore/QObject>
 
@@ -56,6 +57,9 @@ public:
     void resetColors();
     void resetStyle();
     TextStyle currentTextStyle() const;
+    void setCurrentTextStyle(const TextStyle &style);
+    quint16 currentStyleId();
+    void markLiveStyles(QBitArray *live) const;
 
     ColorPalette *colorPalette() const;
     void setTextForegroundColor(QRgb color);
@@ -97,7 +101,7 @@ public:
     void insertAtCursor(const QByteArray &text, bool only_latin = true);
     void replaceAtCursor(const QByteArray &text, bool only_latin = true);
 
-    void lineFeed();
+    void lineFeed(int count = 1);
     void reverseLineFeed();
 
     void setOriginAtMargin(bool atMargin);
@@ -106,8 +110,10 @@ public:
 
     void scrollUp(int lines);
     void scrollDown(int lines);
+    void scrollRegionUp(int lines);
+    void scrollRegionDown(int lines);
 
-    void setTextCodec(QTextCodec *codec);
+    void setCharacterSet(CharacterSet::CharacterSet characterSet);
 
     void setInsertMode(InsertMode mode);
 
@@ -139,8 +145,11 @@ private:
     int adjusted_bottom() const { return m_origin_at_margin ? m_bottom_margin : m_screen_height - 1; }
     int top() const { return m_scroll_margins_set ? m_top_margin : 0; }
     int bottom() const { return m_scroll_margins_set ? m_bottom_margin : m_screen_height - 1; }
+    const QString &decode_text(const QByteArray &data, bool only_latin);
     Screen *m_screen;
     TextStyle m_current_text_style;
+    // Interned id of m_current_text_style, or -1 when it has changed since.
+    int m_current_style_id;
     QPoint m_position;
     QPoint m_new_position;
 
@@ -162,8 +171,10 @@ private:
     bool m_wrap_around;
     bool m_content_height_changed;
 
-    QTextDecoder *m_gl_text_codec;
-    QTextDecoder *m_gr_text_codec;
+    CharacterDecoder m_gl_decoder;
+    QString m_decode_buffer;
+    QString m_layout_buffer;
+    QString m_leading_buffer;
 
     InsertMode m_insert_mode;
 
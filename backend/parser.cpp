@@ -26,92 +26,14 @@
 #include "controll_chars.h"
 #include "screen.h"
 #include "cursor.h"
-#include "nrc_text_codec.h"
+#include "text_scanner.h"
 
-#include <QtCore/QTextCodec>
 #include <QtCore/QDebug>
 #include <QtCore/QLoggingCategory>
 
 
 Q_LOGGING_CATEGORY(lcParser, "yat.parser", QtWarningMsg)
 
-namespace CharacterSet {
-enum CharacterSet {
-    utf_8,
-    ascii,
-    latin_1,
-    dec_special_graphics,
-    nrc_british,
-    nrc_norwegian_danish,
-    nrc_dutch,
-    nrc_finnish,
-    nrc_french,
-    nrc_french_canadian,
-    nrc_german,
-    nrc_italian,
-    nrc_spanish,
-    nrc_swedish,
-    nrc_swiss
-};
-}
-
-QTextCodec *codecForCharacterset(CharacterSet::CharacterSet characterSet) {
-    QTextCodec *codec = 0;
-    switch(characterSet) {
-        case CharacterSet::utf_8:
-            codec = QTextCodec::codecForName("utf-8");
-            break;
-        case CharacterSet::ascii:
-            codec = QTextCodec::codecForName("utf-8");
-            break;
-        case CharacterSet::latin_1:
-            codec = QTextCodec::codecForName("latin-1");
-            break;
-        case CharacterSet::dec_special_graphics:
-            codec = QTextCodec::codecForName("dec_special_graphics");
-            break;
-        case CharacterSet::nrc_british:
-            codec = QTextCodec::codecForName("nrc_british");
-            break;
-        case CharacterSet::nrc_norwegian_danish:
-            codec = QTextCodec::codecForName("nrc_norwegian_danish");
-            break;
-        case CharacterSet::nrc_dutch:
-            codec = QTextCodec::codecForName("nrc_dutch");
-            break;
-        case CharacterSet::nrc_finnish:
-            codec = QTextCodec::codecForName("nrc_finnish");
-            break;
-        case CharacterSet::nrc_french:
-            codec = QTextCodec::codecForName("nrc_french");
-            break;
-        case CharacterSet::nrc_french_canadian:
-            codec = QTextCodec::codecForName("nrc_french_canadian");
-            break;
-        case CharacterSet::nrc_german:
-            codec = QTextCodec::codecForName("nrc_german");
-            break;
-        case CharacterSet::nrc_italian:
-            codec = QTextCodec::codecForName("nrc_italian");
-            break;
-        case CharacterSet::nrc_spanish:
-            codec = QTextCodec::codecForName("nrc_spanish");
-            break;
-        case CharacterSet::nrc_swedish:
-            codec = QTextCodec::codecForName("nrc_swedish");
-            break;
-        case CharacterSet::nrc_swiss:
-            codec = QTextCodec::codecForName("nrc_swiss");
-            break;
-    }
-    if (!codec) {
-        qCWarning(lcParser) << "Failed to find codec for" << characterSet << ". Returning utf-8";
-        return QTextCodec::codecForName("utf-8");
-    }
-    return codec;
-}
-
-
 static const QByteArray getByteArrayMidNoCopy(const QByteArray &array, int start, int length)
 {
     length = std::min(length, array.size() - start);
@@ -122,7 +44,7 @@ static const QByteArray getByteArrayMidNoCopy(const QByteArray &array, int start
     const char *data_at_start = array.data() + start;
     return QByteArray::fromRawData(data_at_start, length);
 }
-static void printParameters(const QVector<int> &parameters, QDebug &debug, bool dec_private = false)
+static void printParameters(const CsiParameters &parameters, QDebug &debug, bool dec_private = false)
 {
     if (dec_private)
         debug << "?";
@@ -130,15 +52,14 @@ static void printParameters(const QVector<int> &parameters, QDebug &debug, bool
         if (i == 0)
             debug << " ";
         else
-            debug << ";";
+            debug << (parameters.isSubParameter(i) ? ":" : ";");
         debug << parameters.at(i);
     }
 }
 
 Parser::Parser(Screen *screen)
-    : m_decode_state(PlainText)
+    : m_vt_state(VtStateMachine::Ground)
     , m_decode_osc_state(None)
-    , m_current_token_start(0)
     , m_current_position(0)
     , m_intermediate_char(QChar())
     , m_parameters_expecting_more(false)
@@ -146,68 +67,169 @@ Parser::Parser(Screen *screen)
     , m_gt_param(false)
     , m_lnm_mode_set(false)
     , m_contains_only_latin(true)
+    , m_model_updates_enabled(true)
     , m_screen(screen)
 {
-    for (uint i = 0; i < sizeof(m_graphic_codecs) / sizeof *m_graphic_codecs; i++) {
-        m_graphic_codecs[i] = QTextCodec::codecForName("utf-8");
+    for (uint i = 0; i < sizeof(m_graphic_sets) / sizeof *m_graphic_sets; i++) {
+        m_graphic_sets[i] = CharacterSet::utf_8;
     }
-
-    NrcTextCodec::initialize();
 }
 
+// Each byte is looked up in the compile time VT500 transition table (see
+// vt_state_machine.h), and the resulting action is run by performAction().
+// Runs of printable bytes are collected and handed to the cursor in one go.
 void Parser::addData(const QByteArray &data)
 {
-    m_current_token_start = 0;
+    using namespace VtStateMachine;
+
     m_current_data = data;
+    const uchar *bytes = reinterpret_cast<const uchar *>(m_current_data.constData());
+    const int size = m_current_data.size();
+    int text_start = -1;
 
-    for (m_current_position = 0; m_current_position < m_current_data.size(); m_current_position++) {
-        uchar character = m_current_data.at(m_current_position);
-        if (character > 127)
-            m_utf8_decoder.addChar(character);
-        switch (m_decode_state) {
-        case PlainText:
-            if (character < C0::C0_END || m_utf8_decoder.isC1()) {
-                if (m_current_position != m_current_token_start) {
-                    const QByteArray to_insert = getByteArrayMidNoCopy(m_current_data, m_current_token_start, m_current_position - m_current_token_start);
-                    qCDebug(lcParser) << "Parser Insert text:" << to_insert;
-                    m_screen->currentCursor()->addAtCursor(to_insert, m_contains_only_latin);
-                    tokenFinished();
-                    m_current_token_start--;
-                }
-                m_decode_state = DecodeC0;
-                decodeC0(m_current_data.at(m_current_position));
+    for (m_current_position = 0; m_current_position < size; m_current_position++) {
+        const uchar character = bytes[m_current_position];
+        const Transition t = transition(m_vt_state, character);
+        const Action action = transitionAction(t);
+
+        if (action == Print) {
+            if (text_start < 0)
+                text_start = m_current_position;
+            if (character > 127) {
+                m_utf8_decoder.addChar(character);
+                m_contains_only_latin = m_contains_only_latin && m_utf8_decoder.isLatin();
+            } else if (m_vt_state == Ground) {
+                // Printable ASCII in Ground is always another Print, so skip
+                // straight to the end of the run.
+                m_current_position = TextScanner::findNonPrintable(m_current_data.constData(), m_current_position + 1, size) - 1;
             }
-            m_contains_only_latin = m_contains_only_latin && m_utf8_decoder.isLatin();
-            break;
-        case DecodeC0:
-            decodeC0(character);
-            break;
-        case DecodeC1_7bit:
-            decodeC1_7bit(character);
-            break;
-        case DecodeCSI:
-            decodeCSI(character);
-            break;
-        case DecodeOSC:
-            decodeOSC(character);
-            break;
-        case DecodeCharacterSet:
-            decodeCharacterSet(character);
-            break;
-        case DecodeFontSize:
-            decodeFontSize(character);
-            break;
-       }
-    }
-    if (m_decode_state == PlainText) {
-        QByteArray to_insert = getByteArrayMidNoCopy(m_current_data, m_current_token_start, m_current_data.size() - m_current_token_start);
-        if (to_insert.size()) {
+            continue;
+        }
+
+        if (text_start >= 0) {
+            const QByteArray to_insert = getByteArrayMidNoCopy(m_current_data, text_start, m_current_position - text_start);
             qCDebug(lcParser) << "Parser Insert text:" << to_insert;
+            if (m_model_updates_enabled)
+                m_screen->currentCursor()->addAtCursor(to_insert, m_contains_only_latin);
+            m_contains_only_latin = true;
+            text_start = -1;
+        }
+
+        if (transitionChangesState(t)) {
+            performAction(exitAction(m_vt_state), character);
+            performAction(action, character);
+            m_vt_state = transitionState(t);
+            performAction(entryAction(m_vt_state), character);
+        } else {
+            performAction(action, character);
+        }
+    }
+
+    if (text_start >= 0) {
+        const QByteArray to_insert = getByteArrayMidNoCopy(m_current_data, text_start, size - text_start);
+        qCDebug(lcParser) << "Parser Insert text:" << to_insert;
+        if (m_model_updates_enabled)
             m_screen->currentCursor()->addAtCursor(to_insert, m_contains_only_latin);
+        m_contains_only_latin = true;
+    }
+    m_current_data = QByteArray();
+}
+
+void Parser::performAction(VtStateMachine::Action action, uchar character)
+{
+    using namespace VtStateMachine;
+
+    if (!m_model_updates_enabled) {
+        switch (action) {
+        case Execute:
+            return;
+        case EscDispatch:
+        case OscEnd:
             tokenFinished();
+            return;
+        case CsiDispatch:
+            appendParameter();
+            tokenFinished();
+            return;
+        default:
+            break;
         }
     }
-    m_current_data = QByteArray();
+
+    switch (action) {
+    case VtStateMachine::None:
+    case Ignore:
+    case Print:
+        break;
+    case Execute:
+        decodeC0(character);
+        break;
+    case Clear:
+        tokenFinished();
+        break;
+    case Collect:
+        collectIntermediate(character);
+        break;
+    case Param:
+        decodeParameters(character);
+        break;
+    case EscDispatch:
+        escDispatch(character);
+        break;
+    case CsiDispatch:
+        appendParameter();
+        dispatchCSI(character);
+        break;
+    case Hook:
+        qCWarning(lcParser) << "Unhandled DCS" << char(character);
+        break;
+    case Put:
+    case Unhook:
+        break;
+    case OscStart:
+        m_decode_osc_state = None;
+        m_osc_data.clear();
+        break;
+    case OscPut:
+        decodeOSC(character);
+        break;
+    case OscEnd:
+        // decodeOSC acts on BEL; ST (ESC \) ends the string the same way.
+        if (m_decode_osc_state != None)
+            decodeOSC(C0::BEL);
+        else
+            tokenFinished();
+        break;
+    case ActionCount:
+        break;
+    }
+}
+
+void Parser::escDispatch(uchar character)
+{
+    switch (m_intermediate_char.unicode()) {
+    case 0:
+        // ST only terminates strings, which the state machine already did.
+        if (character != '\\')
+            decodeC1_7bit(character);
+        else
+            tokenFinished();
+        break;
+    case C1_7bit::SCS_G0:
+    case C1_7bit::SCS_G1:
+    case C1_7bit::SCS_G2:
+    case C1_7bit::SCS_G3:
+        m_decode_graphics_set = m_intermediate_char.unicode() - C1_7bit::SCS_G0;
+        decodeCharacterSet(character);
+        break;
+    case '#':
+        decodeFontSize(character);
+        break;
+    default:
+        qCWarning(lcParser) << "Unhandled escape sequence" << char(m_intermediate_char.unicode()) << char(character);
+        tokenFinished();
+        break;
+    }
 }
 
 void Parser::decodeC0(uchar character)
@@ -222,47 +244,34 @@ void Parser::decodeC0(uchar character)
     case C0::ENQ:
     case C0::ACK:
         qCWarning(lcParser) << "Unhandled" << C0::C0(character);
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
         break;
     case C0::BEL:
         m_screen->scheduleFlash();
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
         break;
     case C0::BS:
         m_screen->currentCursor()->moveLeft();
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
         break;
     case C0::HT:
         m_screen->currentCursor()->moveToNextTab();
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
         break;
     case C0::LF:
     case C0::VT:
-    case C0::FF:
-        if (m_lnm_mode_set)
+    case C0::FF: {
+        bool beginning_of_line = m_lnm_mode_set;
+        const int line_feeds = 1 + consumeLineBreaks(&beginning_of_line);
+        if (beginning_of_line)
             m_screen->currentCursor()->moveBeginningOfLine();
-        m_screen->currentCursor()->lineFeed();
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
+        m_screen->currentCursor()->lineFeed(line_feeds);
         break;
+    }
     case C0::CR:
         m_screen->currentCursor()->moveBeginningOfLine();
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
         break;
     case C0::SOorLS1:
-        m_screen->currentCursor()->setTextCodec(m_graphic_codecs[1]);
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
+        m_screen->currentCursor()->setCharacterSet(m_graphic_sets[1]);
         break;
     case C0::SIorLS0:
-        m_screen->currentCursor()->setTextCodec(m_graphic_codecs[0]);
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
+        m_screen->currentCursor()->setCharacterSet(m_graphic_sets[0]);
         break;
     case C0::DLE:
     case C0::DC1:
@@ -276,18 +285,9 @@ void Parser::decodeC0(uchar character)
     case C0::EM:
     case C0::SUB:
         qCWarning(lcParser) << "Unhandled" << C0::C0(character);
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
         break;
     case C0::ESC:
-        if (m_decode_state != DecodeC0) {
-            tokenFinished();
-            break;
-        }
-        m_decode_state = DecodeC1_7bit;
-        break;
-        if (m_decode_state != DecodeC0)
-            tokenFinished();
+        tokenFinished();
         break;
     case C0::IS4:
     case C0::IS3:
@@ -295,12 +295,34 @@ void Parser::decodeC0(uchar character)
     case C0::IS1:
     default:
         qCWarning(lcParser) << "Unhandled" << C0::C0(character);
-        if (m_decode_state == DecodeC0)
-            tokenFinished();
         break;
     }
 }
 
+// Consumes the CR and LF bytes directly following a line feed in plain text,
+// so that a run of line breaks scrolls the screen in one go. Carriage returns
+// commute with line feeds, so only whether there was one matters. Returns the
+// number of extra line feeds.
+int Parser::consumeLineBreaks(bool *carriage_return)
+{
+    if (m_vt_state != VtStateMachine::Ground)
+        return 0;
+
+    int line_feeds = 0;
+    int position = m_current_position + 1;
+    for (; position < m_current_data.size(); position++) {
+        const uchar character = m_current_data.at(position);
+        if (character == C0::LF)
+            line_feeds++;
+        else if (character == C0::CR)
+            *carriage_return = true;
+        else
+            break;
+    }
+    m_current_position = position - 1;
+    return line_feeds;
+}
+
 void Parser::decodeC1_7bit(uchar character)
 {
     qCDebug(lcParser) << C1_7bit::C1_7bit(character);
@@ -308,25 +330,6 @@ void Parser::decodeC1_7bit(uchar character)
     case C1_7bit::ESC:
         tokenFinished();
         break;
-    case '#':
-        m_decode_state = DecodeFontSize;
-        break;
-    case C1_7bit::SCS_G0:
-        m_decode_state = DecodeCharacterSet;
-        m_decode_graphics_set = 0;
-        break;
-    case C1_7bit::SCS_G1:
-        m_decode_state = DecodeCharacterSet;
-        m_decode_graphics_set = 1;
-        break;
-    case C1_7bit::SCS_G2:
-        m_decode_state = DecodeCharacterSet;
-        m_decode_graphics_set = 2;
-        break;
-    case C1_7bit::SCS_G3:
-        m_decode_state = DecodeCharacterSet;
-        m_decode_graphics_set = 3;
-        break;
     case C1_7bit::DECSC:
         m_screen->saveCursor();
         tokenFinished();
@@ -395,16 +398,10 @@ void Parser::decodeC1_7bit(uchar character)
         qCWarning(lcParser) << "Unhandled" << C1_7bit::C1_7bit(character);
         tokenFinished();
         break;
-    case C1_7bit::CSI:
-        m_decode_state = DecodeCSI;
-        break;
     case C1_7bit::ST :
         qCWarning(lcParser) << "Unhandled" << C1_7bit::C1_7bit(character);
         tokenFinished();
         break;
-    case C1_7bit::OSC:
-        m_decode_state = DecodeOSC;
-        break;
     case 'c':
         qCWarning(lcParser) << "Unhandled hard reset " << C1_7bit::C1_7bit(character);
         tokenFinished();
@@ -431,14 +428,19 @@ void Parser::decodeParameters(uchar character)
     case 0x37:
     case 0x38:
     case 0x39:
-        m_parameter_string.append(character);
+        m_parameters.addDigit(character - 0x30);
         break;
     case 0x3a:
-        qCDebug(lcParser) << "Encountered special delimiter in parameterbyte";
+        if (!m_parameters.hasPendingDigits())
+            m_parameters.append(CsiParameters::Default);
+        else
+            appendParameter();
+        m_parameters.startSubParameter();
+        m_parameters_expecting_more = true;
         break;
     case 0x3b:
-        if (!m_parameter_string.size()) {
-            m_parameters.append(INT_MIN);
+        if (!m_parameters.hasPendingDigits()) {
+            m_parameters.append(CsiParameters::Default);
         } else {
             appendParameter();
         }
@@ -451,7 +453,7 @@ void Parser::decodeParameters(uchar character)
         m_parameters.append(-character);
         break;
     case 0x3e:
-        if (m_parameters.size() == 0 && m_parameter_string.size() == 0) {
+        if (m_parameters.isEmpty() && !m_parameters.hasPendingDigits()) {
             m_gt_param = true;
         } else {
             appendParameter();
@@ -459,7 +461,7 @@ void Parser::decodeParameters(uchar character)
         }
         break;
     case 0x3f:
-        if (m_parameters.size() == 0 && m_parameter_string.size() == 0) {
+        if (m_parameters.isEmpty() && !m_parameters.hasPendingDigits()) {
             m_dec_mode = true;
         } else {
             appendParameter();
@@ -473,319 +475,319 @@ void Parser::decodeParameters(uchar character)
     }
 }
 
-void Parser::decodeCSI(uchar character)
+void Parser::collectIntermediate(uchar character)
 {
-        if (character < C0::C0_END) {
-            decodeC0(character);
-            return;
+    if (m_intermediate_char.unicode())
+        qCWarning(lcParser) << "double intermediate bytes found in CSI";
+    m_intermediate_char = character;
+}
+
+void Parser::dispatchCSI(uchar character)
+{
+    if (m_intermediate_char.unicode()) {
+        if (lcParser().isDebugEnabled()) {
+            QDebug debug = qDebug();
+            debug << FinalBytesSingleIntermediate::FinalBytesSingleIntermediate(character);
+            printParameters(m_parameters, debug, m_dec_mode);
+        }
+        switch (character) {
+        case FinalBytesSingleIntermediate::SL:
+        case FinalBytesSingleIntermediate::SR:
+        case FinalBytesSingleIntermediate::GSM:
+        case FinalBytesSingleIntermediate::GSS:
+        case FinalBytesSingleIntermediate::FNT:
+        case FinalBytesSingleIntermediate::TSS:
+        case FinalBytesSingleIntermediate::JFY:
+        case FinalBytesSingleIntermediate::SPI:
+        case FinalBytesSingleIntermediate::QUAD:
+        case FinalBytesSingleIntermediate::SSU:
+        case FinalBytesSingleIntermediate::PFS:
+        case FinalBytesSingleIntermediate::SHS:
+        case FinalBytesSingleIntermediate::SVS:
+        case FinalBytesSingleIntermediate::IGS:
+        case FinalBytesSingleIntermediate::IDCS:
+        case FinalBytesSingleIntermediate::PPA:
+        case FinalBytesSingleIntermediate::PPR:
+        case FinalBytesSingleIntermediate::PPB:
+        case FinalBytesSingleIntermediate::SPD:
+        case FinalBytesSingleIntermediate::DTA:
+        case FinalBytesSingleIntermediate::SHL:
+        case FinalBytesSingleIntermediate::SLL:
+        case FinalBytesSingleIntermediate::FNK:
+        case FinalBytesSingleIntermediate::SPQR:
+        case FinalBytesSingleIntermediate::SEF:
+        case FinalBytesSingleIntermediate::PEC:
+        case FinalBytesSingleIntermediate::SSW:
+        case FinalBytesSingleIntermediate::SACS:
+        case FinalBytesSingleIntermediate::SAPV:
+        case FinalBytesSingleIntermediate::STAB:
+        case FinalBytesSingleIntermediate::GCC:
+        case FinalBytesSingleIntermediate::TATE:
+        case FinalBytesSingleIntermediate::TALE:
+        case FinalBytesSingleIntermediate::TAC:
+        case FinalBytesSingleIntermediate::TCC:
+        case FinalBytesSingleIntermediate::TSR:
+        case FinalBytesSingleIntermediate::SCO:
+        case FinalBytesSingleIntermediate::SRCS:
+        case FinalBytesSingleIntermediate::SCS:
+        case FinalBytesSingleIntermediate::SLS:
+        case FinalBytesSingleIntermediate::SCP:
+        default:
+            qCWarning(lcParser) << "unhandled CSI" << FinalBytesSingleIntermediate::FinalBytesSingleIntermediate(character);
+            break;
+        }
+        tokenFinished();
+    } else {
+        if (lcParser().isDebugEnabled()) {
+            QDebug debug = qDebug();
+            debug << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            printParameters(m_parameters, debug, m_dec_mode);
+        }
+        switch (character) {
+        case FinalBytesNoIntermediate::ICH: {
+            int n_chars = m_parameters.size() ? m_parameters.at(0) : 1;
+            QByteArray empty(n_chars, ' ');
+            m_screen->currentCursor()->insertAtCursor(empty);
+        }
+            break;
+        case FinalBytesNoIntermediate::CUU: {
+            int move_up = m_parameters.size() ? m_parameters.at(0) : 1;
+            m_screen->currentCursor()->moveUp(move_up ? move_up : 1);
         }
+            break;
+        case FinalBytesNoIntermediate::CUD: {
+            int move_down = m_parameters.size() ? m_parameters.at(0) : 1;
+            m_screen->currentCursor()->moveDown(move_down ? move_down : 1);
+        }
+            break;
+        case FinalBytesNoIntermediate::CUF:{
+            int move_right = m_parameters.size() ? m_parameters.at(0) : 1;
+            m_screen->currentCursor()->moveRight(move_right ? move_right : 1);
+        }
+            break;
+        case FinalBytesNoIntermediate::CUB: {
+            int move_left = m_parameters.size() ? m_parameters.at(0) : 1;
+            m_screen->currentCursor()->moveLeft(move_left ? move_left : 1);
+        }
+            break;
+        case FinalBytesNoIntermediate::CNL:
+        case FinalBytesNoIntermediate::CPL:
+            qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::CHA: {
+            handleDefaultParameters(1);
+            int move_to_pos_on_line = m_parameters.size() ? m_parameters.at(0) : 1;
+            m_screen->currentCursor()->moveToCharacter(move_to_pos_on_line - 1);
+            break;
+        }
+        case FinalBytesNoIntermediate::CUP:
+        case FinalBytesNoIntermediate::HVP: {
+            handleDefaultParameters(1);
+            if (!m_parameters.size()) {
+                m_screen->currentCursor()->moveOrigin();
+            } else if (m_parameters.size() == 2){
+                    m_screen->currentCursor()->move(m_parameters.at(1) - 1, m_parameters.at(0) - 1);
+            } else if (m_parameters.size() == 1){
+                    m_screen->currentCursor()->move(m_parameters.at(0) - 1, 0);
+            }
+            break;
+        }
+        case FinalBytesNoIntermediate::CHT:
+            qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::ED:
+            if (!m_parameters.size()) {
+                m_screen->currentCursor()->clearToEndOfScreen();
+            } else {
+                int param = m_parameters.size() ? m_parameters.at(0) : 0;
+                switch (param) {
+                case 0:
+                    m_screen->currentCursor()->clearToEndOfScreen();
+                    break;
+                case 1:
+                    m_screen->currentCursor()->clearToBeginningOfScreen();
+                    break;
+                case 2:
+                    m_screen->clearScreen();
+                    break;
+                default:
+                    qCWarning(lcParser) << "Invalid parameter value for FinalBytesNoIntermediate::ED";
+                }
+            }
 
-        if (character >= 0x30 && character <= 0x3f) {
-            decodeParameters(character);
-        } else {
-            appendParameter();
-            if (character >= 0x20 && character <= 0x2f) {
-                if (m_intermediate_char.unicode())
-                    qCWarning(lcParser) << "double intermediate bytes found in CSI";
-                m_intermediate_char = character;
-            } else if (character >= 0x40 && character <= 0x7d) {
-                if (m_intermediate_char.unicode()) {
-                    if (lcParser().isDebugEnabled()) {
-                        QDebug debug = qDebug();
-                        debug << FinalBytesSingleIntermediate::FinalBytesSingleIntermediate(character);
-                        printParameters(m_parameters, debug, m_dec_mode);
-                    }
-                    switch (character) {
-                    case FinalBytesSingleIntermediate::SL:
-                    case FinalBytesSingleIntermediate::SR:
-                    case FinalBytesSingleIntermediate::GSM:
-                    case FinalBytesSingleIntermediate::GSS:
-                    case FinalBytesSingleIntermediate::FNT:
-                    case FinalBytesSingleIntermediate::TSS:
-                    case FinalBytesSingleIntermediate::JFY:
-                    case FinalBytesSingleIntermediate::SPI:
-                    case FinalBytesSingleIntermediate::QUAD:
-                    case FinalBytesSingleIntermediate::SSU:
-                    case FinalBytesSingleIntermediate::PFS:
-                    case FinalBytesSingleIntermediate::SHS:
-                    case FinalBytesSingleIntermediate::SVS:
-                    case FinalBytesSingleIntermediate::IGS:
-                    case FinalBytesSingleIntermediate::IDCS:
-                    case FinalBytesSingleIntermediate::PPA:
-                    case FinalBytesSingleIntermediate::PPR:
-                    case FinalBytesSingleIntermediate::PPB:
-                    case FinalBytesSingleIntermediate::SPD:
-                    case FinalBytesSingleIntermediate::DTA:
-                    case FinalBytesSingleIntermediate::SHL:
-                    case FinalBytesSingleIntermediate::SLL:
-                    case FinalBytesSingleIntermediate::FNK:
-                    case FinalBytesSingleIntermediate::SPQR:
-                    case FinalBytesSingleIntermediate::SEF:
-                    case FinalBytesSingleIntermediate::PEC:
-                    case FinalBytesSingleIntermediate::SSW:
-                    case FinalBytesSingleIntermediate::SACS:
-                    case FinalBytesSingleIntermediate::SAPV:
-                    case FinalBytesSingleIntermediate::STAB:
-                    case FinalBytesSingleIntermediate::GCC:
-                    case FinalBytesSingleIntermediate::TATE:
-                    case FinalBytesSingleIntermediate::TALE:
-                    case FinalBytesSingleIntermediate::TAC:
-                    case FinalBytesSingleIntermediate::TCC:
-                    case FinalBytesSingleIntermediate::TSR:
-                    case FinalBytesSingleIntermediate::SCO:
-                    case FinalBytesSingleIntermediate::SRCS:
-                    case FinalBytesSingleIntermediate::SCS:
-                    case FinalBytesSingleIntermediate::SLS:
-                    case FinalBytesSingleIntermediate::SCP:
-                    default:
-                        qCWarning(lcParser) << "unhandled CSI" << FinalBytesSingleIntermediate::FinalBytesSingleIntermediate(character);
-                        break;
-                    }
-                    tokenFinished();
+            break;
+        case FinalBytesNoIntermediate::EL:
+            if (!m_parameters.size() || m_parameters.at(0) == 0) {
+                m_screen->currentCursor()->clearToEndOfLine();
+            } else if (m_parameters.at(0) == 1) {
+                m_screen->currentCursor()->clearToBeginningOfLine();
+            } else if (m_parameters.at(0) == 2) {
+                m_screen->currentCursor()->clearLine();
+            } else{
+                qCWarning(lcParser) << "Fault when processing FinalBytesNoIntermediate::EL";
+            }
+            break;
+        case FinalBytesNoIntermediate::IL: {
+            int count = 1;
+            if (m_parameters.size()) {
+                count = m_parameters.at(0);
+            }
+            m_screen->currentCursor()->scrollUp(count);
+        }
+            break;
+        case FinalBytesNoIntermediate::DL: {
+            int count = 1;
+            if (m_parameters.size()) {
+                count = m_parameters.at(0);
+            }
+            m_screen->currentCursor()->scrollDown(count);
+        }
+            break;
+        case FinalBytesNoIntermediate::EF:
+        case FinalBytesNoIntermediate::EA:
+            qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::DCH:{
+            int n_chars = m_parameters.size() ? m_parameters.at(0) : 1;
+            m_screen->currentCursor()->deleteCharacters(n_chars);
+            break;
+        }
+        case FinalBytesNoIntermediate::ECH:{
+            int n_chars = m_parameters.size() ? m_parameters.at(0) : 1;
+            QByteArray buf(n_chars, ' ');
+            m_screen->currentCursor()->replaceAtCursor(buf, true);
+            break;
+        }
+        case FinalBytesNoIntermediate::SU: {
+            // 0 is the default of 1, as for the other movements.
+            int count = m_parameters.size() ? std::max(1, m_parameters.at(0)) : 1;
+            m_screen->currentCursor()->scrollRegionUp(count);
+            break;
+        }
+        case FinalBytesNoIntermediate::SD: {
+            int count = m_parameters.size() ? std::max(1, m_parameters.at(0)) : 1;
+            m_screen->currentCursor()->scrollRegionDown(count);
+            break;
+        }
+        case FinalBytesNoIntermediate::SSE:
+        case FinalBytesNoIntermediate::CPR:
+        case FinalBytesNoIntermediate::NP:
+        case FinalBytesNoIntermediate::PP:
+        case FinalBytesNoIntermediate::CTC:
+        case FinalBytesNoIntermediate::CVT:
+        case FinalBytesNoIntermediate::CBT:
+        case FinalBytesNoIntermediate::SRS:
+        case FinalBytesNoIntermediate::PTX:
+        case FinalBytesNoIntermediate::SDS:
+        case FinalBytesNoIntermediate::SIMD:
+        case FinalBytesNoIntermediate::HPA:
+        case FinalBytesNoIntermediate::HPR:
+        case FinalBytesNoIntermediate::REP:
+            qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::DA:
+            if (m_gt_param) {
+                m_screen->sendSecondaryDA();
+            } else {
+                m_screen->sendPrimaryDA();
+            }
+            break;
+        case FinalBytesNoIntermediate::VPA: {
+            handleDefaultParameters(1);
+            int move_to_line = m_parameters.size() ? m_parameters.at(0) -1 : 0;
+            m_screen->currentCursor()->moveToLine(move_to_line);
+        }
+            break;
+        case FinalBytesNoIntermediate::VPR:
+            qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::TBC:
+            if (!m_parameters.size() || m_parameters.at(0) == 0) {
+                m_screen->currentCursor()->removeTabStop();
+            } else if (m_parameters.at(0) == 3) {
+                m_screen->currentCursor()->clearTabStops();
+            }
+            break;
+        case FinalBytesNoIntermediate::SM:
+            if (!m_parameters.size()) {
+                qCWarning(lcParser) << FinalBytesNoIntermediate::SM << "called without parameter";
+                break;
+            }
+            for (int i = 0; i < m_parameters.size(); i++) {
+                if (m_dec_mode) {
+                    handleDecMode(m_parameters.at(i), true);
                 } else {
-                    if (lcParser().isDebugEnabled()) {
-                        QDebug debug = qDebug();
-                        debug << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        printParameters(m_parameters, debug, m_dec_mode);
-                    }
-                    switch (character) {
-                    case FinalBytesNoIntermediate::ICH: {
-                        int n_chars = m_parameters.size() ? m_parameters.at(0) : 1;
-                        QByteArray empty(n_chars, ' ');
-                        m_screen->currentCursor()->insertAtCursor(empty);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::CUU: {
-                        int move_up = m_parameters.size() ? m_parameters.at(0) : 1;
-                        m_screen->currentCursor()->moveUp(move_up ? move_up : 1);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::CUD: {
-                        int move_down = m_parameters.size() ? m_parameters.at(0) : 1;
-                        m_screen->currentCursor()->moveDown(move_down ? move_down : 1);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::CUF:{
-                        int move_right = m_parameters.size() ? m_parameters.at(0) : 1;
-                        m_screen->currentCursor()->moveRight(move_right ? move_right : 1);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::CUB: {
-                        int move_left = m_parameters.size() ? m_parameters.at(0) : 1;
-                        m_screen->currentCursor()->moveLeft(move_left ? move_left : 1);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::CNL:
-                    case FinalBytesNoIntermediate::CPL:
-                        qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::CHA: {
-                        handleDefaultParameters(1);
-                        int move_to_pos_on_line = m_parameters.size() ? m_parameters.at(0) : 1;
-                        m_screen->currentCursor()->moveToCharacter(move_to_pos_on_line - 1);
-                        break;
-                    }
-                    case FinalBytesNoIntermediate::CUP:
-                    case FinalBytesNoIntermediate::HVP: {
-                        handleDefaultParameters(1);
-                        if (!m_parameters.size()) {
-                            m_screen->currentCursor()->moveOrigin();
-                        } else if (m_parameters.size() == 2){
-                                m_screen->currentCursor()->move(m_parameters.at(1) - 1, m_parameters.at(0) - 1);
-                        } else if (m_parameters.size() == 1){
-                                m_screen->currentCursor()->move(m_parameters.at(0) - 1, 0);
-                        }
-                        break;
-                    }
-                    case FinalBytesNoIntermediate::CHT:
-                        qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::ED:
-                        if (!m_parameters.size()) {
-                            m_screen->currentCursor()->clearToEndOfScreen();
-                        } else {
-                            int param = m_parameters.size() ? m_parameters.at(0) : 0;
-                            switch (param) {
-                            case 0:
-                                m_screen->currentCursor()->clearToEndOfScreen();
-                                break;
-                            case 1:
-                                m_screen->currentCursor()->clearToBeginningOfScreen();
-                                break;
-                            case 2:
-                                m_screen->clearScreen();
-                                break;
-                            default:
-                                qCWarning(lcParser) << "Invalid parameter value for FinalBytesNoIntermediate::ED";
-                            }
-                        }
-
-                        break;
-                    case FinalBytesNoIntermediate::EL:
-                        if (!m_parameters.size() || m_parameters.at(0) == 0) {
-                            m_screen->currentCursor()->clearToEndOfLine();
-                        } else if (m_parameters.at(0) == 1) {
-                            m_screen->currentCursor()->clearToBeginningOfLine();
-                        } else if (m_parameters.at(0) == 2) {
-                            m_screen->currentCursor()->clearLine();
-                        } else{
-                            qCWarning(lcParser) << "Fault when processing FinalBytesNoIntermediate::EL";
-                        }
-                        break;
-                    case FinalBytesNoIntermediate::IL: {
-                        int count = 1;
-                        if (m_parameters.size()) {
-                            count = m_parameters.at(0);
-                        }
-                        m_screen->currentCursor()->scrollUp(count);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::DL: {
-                        int count = 1;
-                        if (m_parameters.size()) {
-                            count = m_parameters.at(0);
-                        }
-                        m_screen->currentCursor()->scrollDown(count);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::EF:
-                    case FinalBytesNoIntermediate::EA:
-                        qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::DCH:{
-                        int n_chars = m_parameters.size() ? m_parameters.at(0) : 1;
-                        m_screen->currentCursor()->deleteCharacters(n_chars);
-                        break;
-                    }
-                    case FinalBytesNoIntermediate::ECH:{
-                        int n_chars = m_parameters.size() ? m_parameters.at(0) : 1;
-                        QByteArray buf(n_chars, ' ');
-                        m_screen->currentCursor()->replaceAtCursor(buf, true);
-                        break;
-                    }
-                    case FinalBytesNoIntermediate::SSE:
-                    case FinalBytesNoIntermediate::CPR:
-                    case FinalBytesNoIntermediate::SU:
-                    case FinalBytesNoIntermediate::SD:
-                    case FinalBytesNoIntermediate::NP:
-                    case FinalBytesNoIntermediate::PP:
-                    case FinalBytesNoIntermediate::CTC:
-                    case FinalBytesNoIntermediate::CVT:
-                    case FinalBytesNoIntermediate::CBT:
-                    case FinalBytesNoIntermediate::SRS:
-                    case FinalBytesNoIntermediate::PTX:
-                    case FinalBytesNoIntermediate::SDS:
-                    case FinalBytesNoIntermediate::SIMD:
-                    case FinalBytesNoIntermediate::HPA:
-                    case FinalBytesNoIntermediate::HPR:
-                    case FinalBytesNoIntermediate::REP:
-                        qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::DA:
-                        if (m_gt_param) {
-                            m_screen->sendSecondaryDA();
-                        } else {
-                            m_screen->sendPrimaryDA();
-                        }
-                        break;
-                    case FinalBytesNoIntermediate::VPA: {
-                        handleDefaultParameters(1);
-                        int move_to_line = m_parameters.size() ? m_parameters.at(0) -1 : 0;
-                        m_screen->currentCursor()->moveToLine(move_to_line);
-                    }
-                        break;
-                    case FinalBytesNoIntermediate::VPR:
-                        qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::TBC:
-                        if (!m_parameters.size() || m_parameters.at(0) == 0) {
-                            m_screen->currentCursor()->removeTabStop();
-                        } else if (m_parameters.at(0) == 3) {
-                            m_screen->currentCursor()->clearTabStops();
-                        }
-                        break;
-                    case FinalBytesNoIntermediate::SM:
-                        if (!m_parameters.size()) {
-                            qCWarning(lcParser) << FinalBytesNoIntermediate::SM << "called without parameter";
-                            break;
-                        }
-                        for (int i = 0; i < m_parameters.size(); i++) {
-                            if (m_dec_mode) {
-                                handleDecMode(m_parameters.at(i), true);
-                            } else {
-                                handleMode(m_parameters.at(i), true);
-                            }
-                        }
-                        break;
-                    case FinalBytesNoIntermediate::MC:
-                    case FinalBytesNoIntermediate::HPB:
-                    case FinalBytesNoIntermediate::VPB:
-                        qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::RM:
-                        if (!m_parameters.size()) {
-                            qCWarning(lcParser) << FinalBytesNoIntermediate::RM << "called without parameter";
-                            break;
-                        }
-                        for (int i = 0; i < m_parameters.size(); i++) {
-                            if (m_dec_mode) {
-                                handleDecMode(m_parameters.at(i), false);
-                            } else {
-                                handleMode(m_parameters.at(i), false);
-                            }
-                        }
+                    handleMode(m_parameters.at(i), true);
+                }
+            }
+            break;
+        case FinalBytesNoIntermediate::MC:
+        case FinalBytesNoIntermediate::HPB:
+        case FinalBytesNoIntermediate::VPB:
+            qCWarning(lcParser) << "unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::RM:
+            if (!m_parameters.size()) {
+                qCWarning(lcParser) << FinalBytesNoIntermediate::RM << "called without parameter";
+                break;
+            }
+            for (int i = 0; i < m_parameters.size(); i++) {
+                if (m_dec_mode) {
+                    handleDecMode(m_parameters.at(i), false);
+                } else {
+                    handleMode(m_parameters.at(i), false);
+                }
+            }
 
-                        break;
-                    case FinalBytesNoIntermediate::SGR:
-                        handleDefaultParameters(0);
-                        if (!m_parameters.size())
-                            m_parameters << 0;
-                        handleSGR();
-                        break;
-                    case FinalBytesNoIntermediate::DSR:
-                        qCDebug(lcParser) << "report";
-                    case FinalBytesNoIntermediate::DAQ:
-                    case FinalBytesNoIntermediate::Reserved0:
-                        // 'p':
-                        // DECSTR, DECRQM, DECSCL, ...?
-                        qCWarning(lcParser) << "Unhandled reset CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::Reserved1:
-                        qCWarning(lcParser) << "Unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    case FinalBytesNoIntermediate::DECSTBM:
-                        if (m_parameters.size() == 2) {
-                            if (m_parameters.at(0) >= 0) {
-                                m_screen->currentCursor()->setScrollArea(m_parameters.at(0) - 1,m_parameters.at(1) - 1);
-                            } else {
-                                qCWarning(lcParser)<< "Unknown value for scrollRegion" << m_parameters.at(0);
-                            }
-                        } else {
-                            m_screen->currentCursor()->resetScrollArea();
-                        }
-                        m_screen->currentCursor()->moveOrigin();
-                        break;
-                    case FinalBytesNoIntermediate::Reserved3:
-                    case FinalBytesNoIntermediate::Reserved4:
-                    case FinalBytesNoIntermediate::Reserved5:
-                    case FinalBytesNoIntermediate::Reserved6:
-                    case FinalBytesNoIntermediate::Reserved7:
-                    case FinalBytesNoIntermediate::Reserved8:
-                    case FinalBytesNoIntermediate::Reserved9:
-                    case FinalBytesNoIntermediate::Reserveda:
-                    case FinalBytesNoIntermediate::Reservedb:
-                    case FinalBytesNoIntermediate::Reservedc:
-                    case FinalBytesNoIntermediate::Reservedd:
-                    case FinalBytesNoIntermediate::Reservede:
-                    case FinalBytesNoIntermediate::Reservedf:
-                    default:
-                        qCWarning(lcParser) << "Unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
-                        break;
-                    }
-                    tokenFinished();
+            break;
+        case FinalBytesNoIntermediate::SGR:
+            handleDefaultParameters(0);
+            if (!m_parameters.size())
+                m_parameters << 0;
+            handleSGR();
+            break;
+        case FinalBytesNoIntermediate::DSR:
+            qCDebug(lcParser) << "report";
+        case FinalBytesNoIntermediate::DAQ:
+        case FinalBytesNoIntermediate::Reserved0:
+            // 'p':
+            // DECSTR, DECRQM, DECSCL, ...?
+            qCWarning(lcParser) << "Unhandled reset CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::Reserved1:
+            qCWarning(lcParser) << "Unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
+        case FinalBytesNoIntermediate::DECSTBM:
+            if (m_parameters.size() == 2) {
+                if (m_parameters.at(0) >= 0) {
+                    m_screen->currentCursor()->setScrollArea(m_parameters.at(0) - 1,m_parameters.at(1) - 1);
+                } else {
+                    qCWarning(lcParser)<< "Unknown value for scrollRegion" << m_parameters.at(0);
                 }
+            } else {
+                m_screen->currentCursor()->resetScrollArea();
             }
+            m_screen->currentCursor()->moveOrigin();
+            break;
+        case FinalBytesNoIntermediate::Reserved3:
+        case FinalBytesNoIntermediate::Reserved4:
+        case FinalBytesNoIntermediate::Reserved5:
+        case FinalBytesNoIntermediate::Reserved6:
+        case FinalBytesNoIntermediate::Reserved7:
+        case FinalBytesNoIntermediate::Reserved8:
+        case FinalBytesNoIntermediate::Reserved9:
+        case FinalBytesNoIntermediate::Reserveda:
+        case FinalBytesNoIntermediate::Reservedb:
+        case FinalBytesNoIntermediate::Reservedc:
+        case FinalBytesNoIntermediate::Reservedd:
+        case FinalBytesNoIntermediate::Reservede:
+        case FinalBytesNoIntermediate::Reservedf:
+        default:
+            qCWarning(lcParser) << "Unhandled CSI" << FinalBytesNoIntermediate::FinalBytesNoIntermediate(character);
+            break;
         }
+        tokenFinished();
+    }
 }
 
 void Parser::decodeOSC(uchar character)
@@ -848,59 +850,59 @@ void Parser::decodeOSC(uchar character)
 
 void Parser::decodeCharacterSet(uchar character)
 {
-    if (m_decode_graphics_set < 0 || m_decode_graphics_set > (int) (sizeof(m_graphic_codecs) / sizeof(*m_graphic_codecs))) {
-        qCWarning(lcParser) << "Parser state is illigal. m_decode_graphics_set is: " << m_decode_graphics_set << "array size is:" << (sizeof(m_graphic_codecs) / sizeof(*m_graphic_codecs));
+    if (m_decode_graphics_set < 0 || m_decode_graphics_set > (int) (sizeof(m_graphic_sets) / sizeof(*m_graphic_sets))) {
+        qCWarning(lcParser) << "Parser state is illigal. m_decode_graphics_set is: " << m_decode_graphics_set << "array size is:" << (sizeof(m_graphic_sets) / sizeof(*m_graphic_sets));
         m_decode_graphics_set = 0;
         return;
     }
     switch(character) {
         case '0':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::dec_special_graphics);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::dec_special_graphics;
             break;
         case '4':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_dutch);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_dutch;
             break;
         case '5':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_finnish);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_finnish;
             break;
         case '6':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_norwegian_danish);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_norwegian_danish;
             break;
         case '7':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_swedish);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_swedish;
             break;
         case 'A':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_british);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_british;
             break;
         case 'B':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::ascii);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::ascii;
             break;
         case 'C':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_finnish);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_finnish;
             break;
         case 'R':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_french);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_french;
             break;
         case 'Q':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_french_canadian);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_french_canadian;
             break;
         case 'K':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_german);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_german;
             break;
         case 'Y':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_italian);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_italian;
             break;
         case 'E':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_norwegian_danish);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_norwegian_danish;
             break;
         case 'Z':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_spanish);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_spanish;
             break;
         case 'H':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_swedish);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_swedish;
             break;
         case '=':
-            m_graphic_codecs[m_decode_graphics_set] = codecForCharacterset(CharacterSet::nrc_swiss);
+            m_graphic_sets[m_decode_graphics_set] = CharacterSet::nrc_swiss;
             break;
         default:
             qCWarning(lcParser) << "unsupported character set" << character << (char) character;
@@ -1117,8 +1119,141 @@ void Parser::handleDecMode(int mode, bool set)
     }
 }
 
+static bool sgrColor(const CsiParameters &parameters, int *i, const ColorPalette *palette, QRgb *color)
+{
+    const int size = parameters.size();
+    if (*i + 2 < size && parameters.at(*i + 1) == 5) {
+        const int index = parameters.at(*i + 2);
+        if (index < 0 || index > 255)
+            return false;
+        *color = palette->indexedRgb(index);
+        *i += 2;
+        return true;
+    }
+    if (*i + 4 < size && parameters.at(*i + 1) == 2) {
+        const int r = parameters.at(*i + 2);
+        const int g = parameters.at(*i + 3);
+        const int b = parameters.at(*i + 4);
+        if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255)
+            return false;
+        *color = qRgb(r, g, b);
+        *i += 4;
+        return true;
+    }
+    return false;
+}
+
+// The SGR forms programs actually send, applied to a copy of the cursor
+// style that replaces it in one go. Returns false, having changed nothing,
+// for anything else, which handleSGR() then deals with one parameter at a
+// time.
+bool Parser::handleCommonSGR()
+{
+    if (m_parameters.hasSubParameters())
+        return false;
+
+    Cursor *cursor = m_screen->currentCursor();
+    const ColorPalette *palette = m_screen->colorPalette();
+    TextStyle style = cursor->currentTextStyle();
+    for (int i = 0; i < m_parameters.size(); i++) {
+        const int param = m_parameters.at(i);
+        switch (param) {
+        case 0:
+            style.style = TextStyle::Normal;
+            style.foreground = palette->defaultForegroundRgb();
+            style.background = palette->defaultBackgroundRgb();
+            break;
+        case 1:
+            style.style |= TextStyle::Bold;
+            break;
+        case 4:
+            style.style |= TextStyle::Underlined;
+            break;
+        case 5:
+            style.style |= TextStyle::Blinking;
+            break;
+        case 7:
+            style.style |= TextStyle::Inverse;
+            break;
+        case 22:
+            style.style &= ~int(TextStyle::Bold);
+            break;
+        case 24:
+            style.style &= ~int(TextStyle::Underlined);
+            break;
+        case 25:
+            style.style &= ~int(TextStyle::Blinking);
+            break;
+        case 27:
+            style.style &= ~int(TextStyle::Inverse);
+            break;
+        case 30:
+        case 31:
+        case 32:
+        case 33:
+        case 34:
+        case 35:
+        case 36:
+        case 37:
+            style.foreground = palette->indexedRgb(param - 30);
+            break;
+        case 38:
+            if (!sgrColor(m_parameters, &i, palette, &style.foreground))
+                return false;
+            break;
+        case 39:
+            style.foreground = palette->defaultForegroundRgb();
+            break;
+        case 40:
+        case 41:
+        case 42:
+        case 43:
+        case 44:
+        case 45:
+        case 46:
+        case 47:
+            style.background = palette->indexedRgb(param - 40);
+            break;
+        case 48:
+            if (!sgrColor(m_parameters, &i, palette, &style.background))
+                return false;
+            break;
+        case 49:
+            style.background = palette->defaultBackgroundRgb();
+            break;
+        case 90:
+        case 91:
+        case 92:
+        case 93:
+        case 94:
+        case 95:
+        case 96:
+        case 97:
+            style.foreground = palette->indexedRgb(param - 90 + 8);
+            break;
+        case 100:
+        case 101:
+        case 102:
+        case 103:
+        case 104:
+        case 105:
+        case 106:
+        case 107:
+            style.background = palette->indexedRgb(param - 100 + 8);
+            break;
+        default:
+            return false;
+        }
+    }
+    cursor->setCurrentTextStyle(style);
+    return true;
+}
+
 void Parser::handleSGR()
 {
+    if (handleCommonSGR())
+        return;
+
     for (int i = 0; i < m_parameters.size();i++) {
         int param = m_parameters.at(i);
         switch(param) {
@@ -1130,7 +1265,12 @@ void Parser::handleSGR()
                 m_screen->currentCursor()->setTextStyle(TextStyle::Bold);
                 break;
             case 4:
-                m_screen->currentCursor()->setTextStyle(TextStyle::Underlined);
+                // 4:0 turns underlining off; the other styles are all shown
+                // as plain underlines.
+                if (i + 1 < m_parameters.size() && m_parameters.isSubParameter(i + 1))
+                    m_screen->currentCursor()->setTextStyle(TextStyle::Underlined, m_parameters.at(i + 1) != 0);
+                else
+                    m_screen->currentCursor()->setTextStyle(TextStyle::Underlined);
                 break;
             case 5:
                 m_screen->currentCursor()->setTextStyle(TextStyle::Blinking);
@@ -1211,9 +1351,21 @@ void Parser::handleSGR()
                 break;
         }
 
+        // Sub-parameters belong to the attribute before them, whether it
+        // used them or not.
+        while (i + 1 < m_parameters.size() && m_parameters.isSubParameter(i + 1))
+            i++;
     }
 }
 
+static bool xtermIndexedColor(ColorPalette *palette, int cidx, QRgb *color)
+{
+    if (cidx < 0 || cidx > 255)
+        return false;
+    *color = palette->indexedRgb(cidx);
+    return true;
+}
+
 // @return additional bytes consumed beyond the default of 1
 int Parser::handleXtermColor(int param, int i) {
     QRgb color;
@@ -1226,19 +1378,37 @@ int Parser::handleXtermColor(int param, int i) {
         return ret;
     }
 
+    if (m_parameters.isSubParameter(i)) {
+        // 38:5:index, or 38:2:colorspace:r:g:b with the colorspace left out
+        // by most programs that send it.
+        int count = 1;
+        while (i + count < m_parameters.size() && m_parameters.isSubParameter(i + count))
+            count++;
+        bool valid = false;
+        if (m_parameters.at(i) == 5 && count >= 2) {
+            valid = xtermIndexedColor(m_screen->colorPalette(), m_parameters.at(i + 1), &color);
+        } else if (m_parameters.at(i) == 2 && count >= 4) {
+            const int rgb = count >= 5 ? i + 2 : i + 1;
+            color = QColor(m_parameters.at(rgb), m_parameters.at(rgb + 1), m_parameters.at(rgb + 2)).rgb();
+            valid = true;
+        }
+        if (!valid) {
+            qCWarning(lcParser) << "Malformed xterm color sequence! " << m_parameters;
+            return count;
+        }
+        if (param == 38)
+            m_screen->currentCursor()->setTextForegroundColor(color);
+        else
+            m_screen->currentCursor()->setTextBackgroundColor(color);
+        return count;
+    }
+
     switch (m_parameters.at(i)) {
         case 5:
             if (m_parameters.size() >= 3) {
                 int cidx = m_parameters.at(++i);
                 ret = 2;
-                if (cidx >= 16) {
-                    color = m_screen->colorPalette()->xtermRgb(cidx);
-                } else if (cidx >= 8) {
-                    cidx -= 8; /* to take us down to the 0 index'd colors */
-                    color = m_screen->colorPalette()->color(ColorPalette::Color(cidx), true).rgb();
-                } else if (cidx >= 0) {
-                    color = m_screen->colorPalette()->color(ColorPalette::Color(cidx), false).rgb();
-                } else {
+                if (!xtermIndexedColor(m_screen->colorPalette(), cidx, &color)) {
                     qCWarning(lcParser) << "8-bit color bytes unexpected" << m_parameters;
                     return ret;
                 }
@@ -1266,14 +1436,11 @@ int Parser::handleXtermColor(int param, int i) {
 
 void Parser::tokenFinished()
 {
-    m_decode_state = PlainText;
     m_decode_osc_state = None;
     m_osc_data.clear();
 
     m_parameters.clear();
-    m_parameter_string.clear();
 
-    m_current_token_start = m_current_position + 1;
     m_intermediate_char = 0;
 
     m_parameters_expecting_more = false;
@@ -1284,47 +1451,16 @@ void Parser::tokenFinished()
 
 void Parser::appendParameter()
 {
-    if (m_parameter_string.size()) {
-        m_parameters.append(m_parameter_string.toUShort());
-        m_parameter_string.clear();
+    if (m_parameters.finishPending())
         m_parameters_expecting_more = false;
-    }
 }
 
 void Parser::handleDefaultParameters(int defaultValue)
 {
     for (int i = 0; i < m_parameters.size(); i++) {
-        if (m_parameters.at(i) == INT_MIN)
+        if (m_parameters.at(i) == CsiParameters::Default)
             m_parameters.replace(i, defaultValue);
     }
     if (m_parameters_expecting_more)
         m_parameters.append(defaultValue);
 }
-
-QDebug operator<<(QDebug debug, Parser::DecodeState decodeState)
-{
-    switch(decodeState) {
-        case Parser::PlainText:
-            debug << "PlainText";
-            break;
-        case Parser::DecodeC0:
-            debug << "DecodeC0";
-            break;
-        case Parser::DecodeC1_7bit:
-            debug << "DecodeC1_7bit";
-            break;
-        case Parser::DecodeCSI:
-            debug << "DecodeCSI";
-            break;
-        case Parser::DecodeOSC:
-            debug << "DecodeOSC";
-            break;
-        case Parser::DecodeCharacterSet:
-            debug << "DecodeCharacterSet";
-            break;
-        case Parser::DecodeFontSize:
-            debug << "DecodeFontSize";
-            break;
-    }
-    return debug;
-}
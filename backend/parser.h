@@ -29,7 +29,10 @@
 #include <QtCore/QLinkedList>
 
 #include "controll_chars.h"
+#include "csi_parameters.h"
 #include "utf8_decoder.h"
+#include "character_decoder.h"
+#include "vt_state_machine.h"
 
 class Screen;
 
@@ -40,17 +43,15 @@ public:
 
     void addData(const QByteArray &data);
 
-private:
+    // Without model updates, the state machine still runs and parameters
+    // are still collected, but text and control functions leave the screen
+    // alone. This is for timing the parser on its own.
+    void setModelUpdatesEnabled(bool enabled) { m_model_updates_enabled = enabled; }
+    bool modelUpdatesEnabled() const { return m_model_updates_enabled; }
 
-    enum DecodeState {
-        PlainText,
-        DecodeC0,
-        DecodeC1_7bit,
-        DecodeCSI,
-        DecodeOSC,
-        DecodeCharacterSet,
-        DecodeFontSize
-    };
+private:
+    void performAction(VtStateMachine::Action action, uchar character);
+    void escDispatch(uchar character);
 
     enum DecodeOSCState {
         None,
@@ -62,9 +63,11 @@ private:
     };
 
     void decodeC0(uchar character);
+    int consumeLineBreaks(bool *carriage_return);
     void decodeC1_7bit(uchar character);
     void decodeParameters(uchar character);
-    void decodeCSI(uchar character);
+    void collectIntermediate(uchar character);
+    void dispatchCSI(uchar character);
     void decodeOSC(uchar character);
     void decodeCharacterSet(uchar character);
     void decodeFontSize(uchar character);
@@ -72,6 +75,7 @@ private:
     void handleMode(int mode, bool set);
     void handleDecMode(int mode, bool set);
 
+    bool handleCommonSGR();
     void handleSGR();
     int handleXtermColor(int param, int i);
 
@@ -80,32 +84,29 @@ private:
     void appendParameter();
     void handleDefaultParameters(int defaultValue);
 
-    DecodeState m_decode_state;
+    VtStateMachine::State m_vt_state;
     DecodeOSCState m_decode_osc_state;
     QByteArray m_osc_data;
 
     QByteArray m_current_data;
 
-    int m_current_token_start;
     int m_current_position;
 
     QChar m_intermediate_char;
 
-    QByteArray m_parameter_string;
-    QVector<int> m_parameters;
+    CsiParameters m_parameters;
     bool m_parameters_expecting_more;
     bool m_dec_mode;
     bool m_gt_param;
     bool m_lnm_mode_set;
     bool m_contains_only_latin;
+    bool m_model_updates_enabled;
 
     int m_decode_graphics_set;
-    QTextCodec *m_graphic_codecs[4];
+    CharacterSet::CharacterSet m_graphic_sets[4];
     Utf8Decoder m_utf8_decoder;
 
     Screen *m_screen;
-    friend QDebug operator<<(QDebug debug, DecodeState decodeState);
 };
-QDebug operator<<(QDebug debug, Parser::DecodeState decodeState);
 
 #endif // PARSER_H
@@ -32,7 +32,6 @@
 #include "selection.h"
 
 #include "controll_chars.h"
-#include "character_sets.h"
 
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
@@ -43,9 +42,21 @@
 
 #include <float.h>
 #include <cmath>
+#include <limits>
 
 Q_LOGGING_CATEGORY(lcScreen, "yat.screen", QtWarningMsg)
 
+// The backlog is parsed in slices of this size, checking the time limit
+// after each.
+static const int parseSliceSize = 16 * 1024;
+
+// How long a frame paced dispatch waits for a frame before it goes ahead
+// anyway, e.g. because the window is hidden.
+static const int fallbackDispatchInterval = 100;
+
+// Lines of scrollback until scrollbackSize is set.
+static const int defaultScrollbackSize = 500;
+
 /*!
      Creates a new screen instance with the specified \a parent. If \a testMode
      is true, then the pty will not be connected, with the expectation being that
@@ -55,21 +66,36 @@ Q_LOGGING_CATEGORY(lcScreen, "yat.screen", QtWarningMsg)
 Screen::Screen(QObject *parent, bool testMode)
     : QObject(parent)
     , m_palette(new ColorPalette(this))
+    , m_style_table(this)
+    , m_default_style_id(m_style_table.intern(defaultTextStyle()))
+    , m_cluster_table(this)
     , m_parser(this)
+    , m_read_backlog_offset(0)
+    , m_read_backlog_limit(4 * 1024 * 1024)
+    , m_parse_time_limit(8)
+    , m_parsed_since_dispatch(0)
+    , m_parse_scheduled(false)
     , m_timer_event_id(0)
     , m_width(1)
     , m_new_width(80)
     , m_height(1)
     , m_new_height(25)
-    , m_primary_data(new ScreenData(500, this))
+    , m_primary_data(new ScreenData(defaultScrollbackSize, this))
     , m_alternate_data(new ScreenData(0, this))
     , m_current_data(m_primary_data)
     , m_old_current_data(m_primary_data)
+    , m_scrollback_size(defaultScrollbackSize)
+    , m_scrollback_memory_limit(0)
+    , m_scrollback_spill(false)
+    , m_scrollback_lines(0)
+    , m_scrollback_memory(0)
     , m_selection(new Selection(this))
     , m_flash(false)
     , m_cursor_changed(false)
     , m_application_cursor_key_mode(false)
     , m_fast_scroll(true)
+    , m_frame_paced(false)
+    , m_block_renderer(0)
     , m_default_background(m_palette->normalColor(ColorPalette::DefaultBackground))
 {
     Cursor *cursor = new Cursor(this);
@@ -198,6 +224,23 @@ TextStyle Screen::defaultTextStyle() const
     return style;
 }
 
+// Called by the style table when it runs out of ids.
+void Screen::markLiveStyles(QBitArray *live) const
+{
+    live->setBit(m_default_style_id);
+    for (Cursor *cursor : m_cursor_stack)
+        cursor->markLiveStyles(live);
+    m_primary_data->markLiveStyles(live);
+    m_alternate_data->markLiveStyles(live);
+}
+
+// Called by the cluster table when it runs out of ids.
+void Screen::markLiveClusters(QBitArray *live) const
+{
+    m_primary_data->markLiveClusters(live);
+    m_alternate_data->markLiveClusters(live);
+}
+
 void Screen::saveCursor()
 {
     Cursor *new_cursor = new Cursor(this);
@@ -249,6 +292,43 @@ bool Screen::fastScroll() const
     return m_fast_scroll;
 }
 
+void Screen::setScrollbackSize(int lines)
+{
+    lines = std::max(lines, -1);
+    if (lines == m_scrollback_size)
+        return;
+    m_scrollback_size = lines;
+    applyScrollbackLimits();
+    emit scrollbackSizeChanged();
+}
+
+void Screen::setScrollbackMemoryLimit(qint64 bytes)
+{
+    bytes = std::max<qint64>(bytes, 0);
+    if (bytes == m_scrollback_memory_limit)
+        return;
+    m_scrollback_memory_limit = bytes;
+    applyScrollbackLimits();
+    emit scrollbackMemoryLimitChanged();
+}
+
+void Screen::setScrollbackSpill(bool spill)
+{
+    if (spill == m_scrollback_spill)
+        return;
+    m_scrollback_spill = spill;
+    applyScrollbackLimits();
+    emit scrollbackSpillChanged();
+}
+
+void Screen::applyScrollbackLimits()
+{
+    const size_t max_lines = m_scrollback_size < 0 ? std::numeric_limits<size_t>::max()
+                                                   : size_t(m_scrollback_size);
+    m_primary_data->setScrollbackLimits(max_lines, m_scrollback_memory_limit, m_scrollback_spill);
+    scheduleEventDispatch();
+}
+
 Selection *Screen::selection() const
 {
     return m_selection;
@@ -299,6 +379,14 @@ void Screen::printScreen() const
 
 void Screen::scheduleEventDispatch()
 {
+    if (m_frame_paced) {
+        if (!m_timer_event_id) {
+            m_timer_event_id = startTimer(fallbackDispatchInterval);
+            emit frameRequested();
+        }
+        return;
+    }
+
     if (!m_timer_event_id) {
         qCDebug(lcScreen) << "Scheduling dispatch";
         m_timer_event_id = startTimer(1);
@@ -359,6 +447,9 @@ void Screen::dispatchChanges()
     currentScreenData()->dispatchLineEvents();
     emit dispatchTextSegmentChanges();
 
+    m_parsed_since_dispatch = 0;
+    updateReadEnabled();
+
     //be smarter than this
     static int max_to_delete_size = 0;
     if (max_to_delete_size < m_to_delete.size()) {
@@ -388,6 +479,14 @@ void Screen::dispatchChanges()
     }
 
     m_selection->dispatchChanges();
+
+    const int scrollback_lines = m_primary_data->scrollbackHeight();
+    const qint64 scrollback_memory = m_primary_data->scrollbackMemory();
+    if (scrollback_lines != m_scrollback_lines || scrollback_memory != m_scrollback_memory) {
+        m_scrollback_lines = scrollback_lines;
+        m_scrollback_memory = scrollback_memory;
+        emit scrollbackStatsChanged();
+    }
 }
 
 void Screen::sendPrimaryDA()
@@ -425,10 +524,12 @@ Text *Screen::createTextSegment(const TextStyleLine &style_line)
 {
     Q_UNUSED(style_line);
     Text *to_return;
+    m_text_segment_stats.acquired++;
     if (m_to_delete.size()) {
         to_return = m_to_delete.takeLast();
         to_return->setVisible(true);
     } else {
+        m_text_segment_stats.created++;
         to_return = new Text(this);
         emit textCreated(to_return);
     }
@@ -438,18 +539,86 @@ Text *Screen::createTextSegment(const TextStyleLine &style_line)
 
 void Screen::releaseTextSegment(Text *text)
 {
+    m_text_segment_stats.released++;
     m_to_delete.append(text);
 }
 
+// Hands drawing the blocks over to renderer, or back to Text objects when it
+// is null. Whatever is on screen gets dispatched again to the new owner.
+void Screen::setBlockRenderer(BlockRenderer *renderer)
+{
+    if (renderer == m_block_renderer)
+        return;
+
+    m_primary_data->releaseTextObjects();
+    m_alternate_data->releaseTextObjects();
+    m_block_renderer = renderer;
+    scheduleEventDispatch();
+}
+
+void Screen::setReadBacklogLimit(int bytes)
+{
+    m_read_backlog_limit = std::max(1, bytes);
+    updateReadEnabled();
+}
+
+void Screen::setParseTimeLimit(int msecs)
+{
+    m_parse_time_limit = std::max(1, msecs);
+}
+
 void Screen::readData(const QByteArray &data)
 {
-    m_parser.addData(data);
+    if (!readBacklog()) {
+        m_read_backlog.clear();
+        m_read_backlog_offset = 0;
+    }
+    m_read_backlog.append(data);
+    parseReadBacklog();
+}
+
+// Parses for at most the time limit, then leaves the rest to a later turn
+// of the event loop, so that input and rendering keep up with a flood of
+// output.
+void Screen::parseReadBacklog()
+{
+    m_parse_scheduled = false;
+
+    QElapsedTimer parse_time;
+    parse_time.start();
+    while (readBacklog()) {
+        const int slice = std::min(parseSliceSize, readBacklog());
+        m_parser.addData(QByteArray::fromRawData(m_read_backlog.constData() + m_read_backlog_offset, slice));
+        m_read_backlog_offset += slice;
+        m_parsed_since_dispatch += slice;
+        if (parse_time.elapsed() >= m_parse_time_limit)
+            break;
+    }
+
+    if (readBacklog()) {
+        if (m_read_backlog_offset > m_read_backlog.size() / 2) {
+            m_read_backlog.remove(0, m_read_backlog_offset);
+            m_read_backlog_offset = 0;
+        }
+        if (!m_parse_scheduled) {
+            m_parse_scheduled = true;
+            QTimer::singleShot(0, this, &Screen::parseReadBacklog);
+        }
+    }
 
+    updateReadEnabled();
     scheduleEventDispatch();
 }
 
+void Screen::updateReadEnabled()
+{
+    m_pty.setReadEnabled(readBacklog() + m_parsed_since_dispatch < m_read_backlog_limit);
+}
+
 void Screen::paletteChanged()
 {
+    m_default_style_id = m_style_table.intern(defaultTextStyle());
+
     QColor new_default = m_palette->normalColor(ColorPalette::DefaultBackground);
     if (new_default != m_default_background) {
         m_default_background = new_default;
@@ -457,8 +626,43 @@ void Screen::paletteChanged()
     }
 }
 
+void Screen::setFramePaced(bool paced)
+{
+    if (paced == m_frame_paced)
+        return;
+
+    const bool pending = m_timer_event_id;
+    if (pending) {
+        killTimer(m_timer_event_id);
+        m_timer_event_id = 0;
+    }
+    m_frame_paced = paced;
+    if (pending)
+        scheduleEventDispatch();
+}
+
+// Returns whether there was anything to dispatch.
+bool Screen::dispatchFrame()
+{
+    if (!m_frame_paced || !m_timer_event_id)
+        return false;
+
+    killTimer(m_timer_event_id);
+    m_timer_event_id = 0;
+    dispatchChanges();
+    return true;
+}
+
 void Screen::timerEvent(QTimerEvent *)
 {
+    if (m_frame_paced) {
+        qCDebug(lcScreen) << "No frame in time, dispatching from the fallback timer";
+        killTimer(m_timer_event_id);
+        m_timer_event_id = 0;
+        dispatchChanges();
+        return;
+    }
+
     if (m_timer_event_id && (m_time_since_parsed.elapsed() > 3 || m_time_since_initiated.elapsed() > 25)) {
         qCDebug(lcScreen) << "Preparing to dispatch time_since_parsed " << m_time_since_parsed.elapsed() << " time_since_initiated " << m_time_since_initiated.elapsed();
         killTimer(m_timer_event_id);
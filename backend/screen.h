@@ -30,6 +30,7 @@
 #include "parser.h"
 #include "yat_pty.h"
 #include "text_style.h"
+#include "char_width.h"
 
 #include <QtCore/QPoint>
 #include <QtCore/QSize>
@@ -37,6 +38,7 @@
 #include <QtCore/QElapsedTimer>
 
 class Block;
+class BlockRenderer;
 class Cursor;
 class Text;
 class ScreenData;
@@ -53,6 +55,11 @@ class Screen : public QObject
     Q_PROPERTY(Selection *selection READ selection CONSTANT)
     Q_PROPERTY(QColor defaultBackgroundColor READ defaultBackgroundColor NOTIFY defaultBackgroundColorChanged)
     Q_PROPERTY(QString platformName READ platformName CONSTANT)
+    Q_PROPERTY(int scrollbackSize READ scrollbackSize WRITE setScrollbackSize NOTIFY scrollbackSizeChanged)
+    Q_PROPERTY(qint64 scrollbackMemoryLimit READ scrollbackMemoryLimit WRITE setScrollbackMemoryLimit NOTIFY scrollbackMemoryLimitChanged)
+    Q_PROPERTY(bool scrollbackSpill READ scrollbackSpill WRITE setScrollbackSpill NOTIFY scrollbackSpillChanged)
+    Q_PROPERTY(int scrollbackLines READ scrollbackLines NOTIFY scrollbackStatsChanged)
+    Q_PROPERTY(qint64 scrollbackMemory READ scrollbackMemory NOTIFY scrollbackStatsChanged)
 
 public:
     explicit Screen(QObject *parent = 0, bool testMode = false);
@@ -76,6 +83,11 @@ public:
     void restoreCursor();
 
     TextStyle defaultTextStyle() const;
+    quint16 defaultStyleId() const { return m_default_style_id; }
+    TextStyleTable &styleTable() { return m_style_table; }
+    void markLiveStyles(QBitArray *live) const;
+    ClusterTable &clusterTable() { return m_cluster_table; }
+    void markLiveClusters(QBitArray *live) const;
 
     QColor defaultForegroundColor() const;
     QColor defaultBackgroundColor() const;
@@ -90,6 +102,19 @@ public:
     void setFastScroll(bool fast);
     bool fastScroll() const;
 
+    // Lines of scrollback kept for the normal screen, or -1 to keep as much
+    // as the memory limit (in bytes, 0 for none) allows.
+    int scrollbackSize() const { return m_scrollback_size; }
+    void setScrollbackSize(int lines);
+    qint64 scrollbackMemoryLimit() const { return m_scrollback_memory_limit; }
+    void setScrollbackMemoryLimit(qint64 bytes);
+    // Rather than evicting what is over the memory limit, keep it in a
+    // temporary file.
+    bool scrollbackSpill() const { return m_scrollback_spill; }
+    void setScrollbackSpill(bool spill);
+    int scrollbackLines() const { return m_scrollback_lines; }
+    qint64 scrollbackMemory() const { return m_scrollback_memory; }
+
     Selection *selection() const;
     Q_INVOKABLE void doubleClicked(double character, double line);
 
@@ -105,6 +130,13 @@ public:
     void scheduleEventDispatch();
     void dispatchChanges();
 
+    // When frame paced, changes wait for the window to call dispatchFrame()
+    // as it prepares the next frame, with a coarse timer as a fallback for
+    // when it does not render.
+    void setFramePaced(bool paced);
+    bool framePaced() const { return m_frame_paced; }
+    bool dispatchFrame();
+
     void sendPrimaryDA();
     void sendSecondaryDA();
 
@@ -115,10 +147,41 @@ public:
 
     YatPty *pty();
 
+    // Output that has been read but not parsed yet. Together with what has
+    // been parsed but not dispatched, over the limit, reading from the pty
+    // pauses until the parser and the dispatch catch up.
+    int readBacklog() const { return m_read_backlog.size() - m_read_backlog_offset; }
+    int undispatchedBytes() const { return m_parsed_since_dispatch; }
+    void setReadBacklogLimit(int bytes);
+    int readBacklogLimit() const { return m_read_backlog_limit; }
+    // How long one turn of the event loop may spend parsing.
+    void setParseTimeLimit(int msecs);
+    int parseTimeLimit() const { return m_parse_time_limit; }
+
     Q_INVOKABLE void ensureVisibleLines(int top_line);
     Text *createTextSegment(const TextStyleLine &style_line);
     void releaseTextSegment(Text *text);
 
+    struct TextSegmentStats
+    {
+        TextSegmentStats()
+            : acquired(0)
+            , released(0)
+            , created(0)
+        {
+        }
+
+        // Segments handed out and given back to the pool, and the ones that
+        // had to be created because the pool was empty.
+        quint64 acquired;
+        quint64 released;
+        quint64 created;
+    };
+    TextSegmentStats textSegmentStats() const { return m_text_segment_stats; }
+
+    void setBlockRenderer(BlockRenderer *renderer);
+    BlockRenderer *blockRenderer() const { return m_block_renderer; }
+
 public slots:
     void readData(const QByteArray &data);
     void paletteChanged();
@@ -144,20 +207,38 @@ signals:
 
     void defaultBackgroundColorChanged();
 
+    void scrollbackSizeChanged();
+    void scrollbackMemoryLimitChanged();
+    void scrollbackSpillChanged();
+    void scrollbackStatsChanged();
+
     void contentModified(size_t lineModified, int lineDiff, int contentDiff);
     void widthAboutToChange();
     void dataSizeChanged(int newWidth, int newHeight, int removedBeginning, int reclaimed);
 
     void hangup();
+    void frameRequested();
 protected:
     void timerEvent(QTimerEvent *);
 
 private:
     void dispatchGeometryChanges();
+    void parseReadBacklog();
+    void updateReadEnabled();
+    void applyScrollbackLimits();
 
     ColorPalette *m_palette;
+    TextStyleTable m_style_table;
+    quint16 m_default_style_id;
+    ClusterTable m_cluster_table;
     YatPty m_pty;
     Parser m_parser;
+    QByteArray m_read_backlog;
+    int m_read_backlog_offset;
+    int m_read_backlog_limit;
+    int m_parse_time_limit;
+    int m_parsed_since_dispatch;
+    bool m_parse_scheduled;
     QElapsedTimer m_time_since_parsed;
     QElapsedTimer m_time_since_initiated;
 
@@ -172,6 +253,12 @@ private:
     ScreenData *m_current_data;
     ScreenData *m_old_current_data;
 
+    int m_scrollback_size;
+    qint64 m_scrollback_memory_limit;
+    bool m_scrollback_spill;
+    int m_scrollback_lines;
+    qint64 m_scrollback_memory;
+
     QVector<Cursor *> m_cursor_stack;
     QVector<Cursor *> m_new_cursors;
     QVector<Cursor *> m_delete_cursors;
@@ -184,8 +271,11 @@ private:
     bool m_cursor_changed;
     bool m_application_cursor_key_mode;
     bool m_fast_scroll;
+    bool m_frame_paced;
 
     QVector<Text *> m_to_delete;
+    TextSegmentStats m_text_segment_stats;
+    BlockRenderer *m_block_renderer;
 
     QColor m_default_background;
 
@@ -32,19 +32,29 @@
 
 #include <QtGui/QGuiApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QIODevice>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QTimer>
 
 Q_LOGGING_CATEGORY(lcScreenData, "yat.screen_data", QtWarningMsg)
 
+// How long one turn of the event loop may spend reflowing the scrollback.
+static const int reflowSliceTime = 4;
+
 ScreenData::ScreenData(size_t max_scrollback, Screen *screen)
     : QObject(screen)
     , m_screen(screen)
-    , m_scrollback(new Scrollback(max_scrollback))
+    , m_scrollback(new Scrollback(max_scrollback, screen))
     , m_screen_height(0)
     , m_height(0)
     , m_width(0)
     , m_block_count(0)
     , m_old_total_lines(0)
+    , m_pushed_since_dispatch(0)
+    , m_reflow_scheduled(false)
+    , m_row_index_head(0)
+    , m_row_index_lines(0)
+    , m_row_index_valid(false)
 {
 }
 
@@ -62,6 +72,36 @@ int ScreenData::contentHeight() const
     return m_height + m_scrollback->height();
 }
 
+void ScreenData::setScrollbackLimits(size_t max_lines, size_t memory_limit, bool spill)
+{
+    const size_t old_content_height = contentHeight();
+    m_scrollback->setMaxSize(max_lines);
+    m_scrollback->setMemoryLimit(memory_limit);
+    m_scrollback->setSpillEnabled(spill);
+
+    // Lines were dropped from the top, so everything below moved up.
+    const int content_diff = content_height_diff(old_content_height);
+    if (content_diff) {
+        emit contentModified(old_content_height, 0, content_diff);
+        emit contentHeightChanged();
+    }
+}
+
+size_t ScreenData::scrollbackHeight() const
+{
+    return m_scrollback->height();
+}
+
+size_t ScreenData::scrollbackMemory() const
+{
+    return m_scrollback->memoryUsage();
+}
+
+qint64 ScreenData::scrollbackSpillFileSize() const
+{
+    return m_scrollback->spillFileSize();
+}
+
 void ScreenData::setSize(int width, int height, int currentCursorLine)
 {
     const int oldWidth = m_width;
@@ -73,6 +113,7 @@ void ScreenData::setSize(int width, int height, int currentCursorLine)
 
     if (width != m_width) {
         m_width = width;
+        invalidate_row_index();
 
         for (Block *block : m_screen_blocks) {
             int before_count = block->lineCount();
@@ -81,6 +122,7 @@ void ScreenData::setSize(int width, int height, int currentCursorLine)
         }
 
         m_scrollback->setWidth(screen()->height(), width);
+        schedule_reflow();
 
         if (m_height > m_screen_height) {
             int to_remove = m_height - m_screen_height;
@@ -179,6 +221,32 @@ void ScreenData::releaseTextObjects()
     }
 }
 
+void ScreenData::markLiveStyles(QBitArray *live) const
+{
+    for (Block *block : m_screen_blocks)
+        block->markLiveStyles(live);
+    m_scrollback->markLiveStyles(live);
+}
+
+void ScreenData::markLiveClusters(QBitArray *live) const
+{
+    for (Block *block : m_screen_blocks)
+        block->markLiveClusters(live);
+    m_scrollback->markLiveClusters(live);
+}
+
+// For zero width characters that come after the one they belong to was
+// written. There is nothing for them to attach to at the start of a line,
+// so there they are dropped, as xterm does.
+void ScreenData::attachToPreviousCell(const QPoint &pos, const QString &text)
+{
+    auto it = it_for_row(pos.y());
+    if (it == m_screen_blocks.end())
+        return;
+    Block *block = *it;
+    block->attachToCell((pos.y() - block->screenIndex()) * m_width + pos.x() - 1, text);
+}
+
 void ScreenData::clearCharacters(const QPoint &point, int to)
 {
     auto it = it_for_row_ensure_single_line_block(point.y());
@@ -194,62 +262,129 @@ void ScreenData::deleteCharacters(const QPoint &point, int to)
     int line_in_block = point.y() - (*it)->screenIndex();
     int chars_to_line = line_in_block * m_width;
 
+    const int lines_before = (*it)->lineCount();
     (*it)->deleteCharacters(chars_to_line + point.x(), chars_to_line + to);
+    if ((*it)->lineCount() != lines_before)
+        invalidate_row_index();
 }
 
-const CursorDiff ScreenData::replace(const QPoint &point, const QString &text, const TextStyle &style, bool only_latin)
+const CursorDiff ScreenData::replace(const QPoint &point, const QString &text, quint16 style, bool only_latin)
 {
     return modify(point,text,style,true, only_latin);
 }
 
-const CursorDiff ScreenData::insert(const QPoint &point, const QString &text, const TextStyle &style, bool only_latin)
+const CursorDiff ScreenData::insert(const QPoint &point, const QString &text, quint16 style, bool only_latin)
 {
     return modify(point,text,style,false, only_latin);
 }
 
 
-void ScreenData::moveLine(int from, int to)
+void ScreenData::moveLines(int from, int to, int count)
 {
-    if (from == to)
+    if (count <= 0)
         return;
 
-    const size_t old_content_height = contentHeight();
-    if (to > from)
-        to++;
-    auto from_it = it_for_row_ensure_single_line_block(from);
-    auto to_it = it_for_row_ensure_single_line_block(to);
+    if (from == to) {
+        for (int i = 0; i < count; i++)
+            (*it_for_row_ensure_single_line_block(from + i))->clear();
+        return;
+    }
 
-    (*from_it)->clear();
-    m_screen_blocks.splice(to_it, m_screen_blocks, from_it);
-    emit contentModified(m_scrollback->height() + to, 1, content_height_diff(old_content_height));
+    const size_t old_content_height = contentHeight();
+    // The moved lines are spliced in front of the line at dest_row.
+    const int dest_row = to > from ? to + count : to;
+    auto to_it = it_for_row_ensure_single_line_block(dest_row);
+    auto first = it_for_row_ensure_single_line_block(from);
+    auto last = first;
+    for (int i = 1; i < count; i++)
+        last = it_for_row_ensure_single_line_block(from + i);
+    ++last;
+
+    for (auto it = first; it != last; ++it)
+        (*it)->clear();
+    m_screen_blocks.splice(to_it, m_screen_blocks, first, last);
+    if (m_row_index_valid)
+        row_index_move(row_index_line(from), row_index_line(to), count);
+    emit contentModified(m_scrollback->height() + dest_row, count, content_height_diff(old_content_height));
 }
 
-void ScreenData::insertLine(int row, int topMargin)
+void ScreenData::insertLines(int row, int topMargin, int count)
 {
+    if (count <= 0)
+        return;
+
+    // Lines inserted below row only reach the top after row + 1 steps, so
+    // any further lines scroll out the fresh lines from the earlier steps.
+    // They go in chunks of row + 1, leaving the rest for below.
+    while (!topMargin && count > row + 1) {
+        insertLines(row, topMargin, row + 1);
+        count -= row + 1;
+    }
+
     auto row_it = it_for_row(row + 1);
 
     const size_t old_content_height = contentHeight();
 
-    if (!topMargin && m_height >= m_screen_height) {
-        push_at_most_to_scrollback(1);
+    // Only when the new blocks land right above row + 1 can the lines be
+    // moved in bulk and the row index be updated in place.
+    const bool lands_on_row = it_is_end(row_it) ? row + 1 == m_screen_height
+                                                : (*row_it)->screenIndex() == row + 1;
+
+    // A block straddling row + 1 takes the lines one at a time.
+    if (!lands_on_row && count > 1) {
+        for (int i = 0; i < count; i++)
+            insertLines(row, topMargin, 1);
+        return;
+    }
+
+    // Scrolling one line at a time never pushes out a wrapped block, so only
+    // count the single line blocks in front of the first one.
+    int to_push = 0;
+    const bool scroll_screen = !topMargin && m_height >= m_screen_height;
+    if (scroll_screen && m_height > 1) {
+        for (auto it = m_screen_blocks.begin(); to_push < count && it != m_screen_blocks.end()
+                && (*it)->lineCount() == 1; ++it)
+            to_push++;
     } else {
-        auto row_top_margin = it_for_row_ensure_single_line_block(topMargin);
         if (row == topMargin) {
-            (*row_top_margin)->clear();
+            (*it_for_row_ensure_single_line_block(topMargin))->clear();
             return;
         }
-        delete (*row_top_margin);
-        m_screen_blocks.erase(row_top_margin);
-        m_height--;
-        m_block_count--;
+        count = std::min(count, row - topMargin + 1);
+        auto first = it_for_row_ensure_single_line_block(topMargin);
+        auto last = first;
+        for (int i = 1; i < count; i++)
+            last = it_for_row_ensure_single_line_block(topMargin + i);
+        ++last;
+        for (auto it = first; it != last; ++it)
+            delete *it;
+        m_screen_blocks.erase(first, last);
+        m_height -= count;
+        m_block_count -= count;
+        if (m_row_index_valid)
+            row_index_remove(row_index_line(topMargin), count);
     }
 
-    Block *block_to_insert = new Block(m_screen);
-    m_screen_blocks.insert(row_it,block_to_insert);
-    m_height++;
-    m_block_count++;
+    auto inserted = row_it;
+    for (int i = 0; i < count; i++)
+        inserted = m_screen_blocks.insert(inserted, new Block(m_screen));
+    m_height += count;
+    m_block_count += count;
+
+    // Pushing after the insert keeps at least count lines on screen, just
+    // like pushing one line before each insert would.
+    push_at_most_to_scrollback(to_push);
+
+    // The row index has not seen the new blocks yet, but has seen lines
+    // leave the top, so row + 1 is where they go.
+    if (m_row_index_valid) {
+        if (lands_on_row)
+            row_index_insert(row_index_line(row + 1), inserted, count);
+        else
+            invalidate_row_index();
+    }
 
-    emit contentModified(m_scrollback->height() + row + 1, 1, content_height_diff(old_content_height));
+    emit contentModified(m_scrollback->height() + row + 1, count, content_height_diff(old_content_height));
 }
 
 
@@ -259,12 +394,14 @@ void ScreenData::fill(const QChar &character)
     auto it = --m_screen_blocks.end();
     for (int i = 0; i < m_block_count; --it, i++) {
         QString fill_str(m_screen->width(), character);
-        (*it)->replaceAtPos(0, fill_str, m_screen->defaultTextStyle());
+        (*it)->replaceAtPos(0, fill_str, m_screen->defaultStyleId());
     }
 }
 
 void ScreenData::dispatchLineEvents()
 {
+    m_pushed_since_dispatch = 0;
+
     if (!m_block_count)
         return;
 
@@ -321,55 +458,118 @@ void ScreenData::ensureVisibleLines(int top_line)
     m_scrollback->ensureVisibleLines(screen()->height(), top_line);
 }
 
-void ScreenData::sendSelectionToClipboard(const QPoint &start, const QPoint &end, QClipboard::Mode mode)
+// Splits a selection in content coordinates into the part in the scrollback
+// and the part on screen, in screen coordinates.
+bool ScreenData::selection_span(const QPoint &start, const QPoint &end, SelectionSpan *span)
 {
     if (start.y() < 0)
-        return;
+        return false;
     if (end.y() >= contentHeight())
-        return;
+        return false;
 
-    QString to_clip_board_buffer;
+    const size_t scrollback_height = m_scrollback->height();
+    span->in_scrollback = size_t(start.y()) < scrollback_height;
+    span->on_screen = size_t(end.y()) >= scrollback_height;
+    span->scrollback_end = span->on_screen ? QPoint(m_width, scrollback_height - 1) : end;
+    span->screen_start = span->in_scrollback ? QPoint(0, 0) : start - QPoint(0, scrollback_height);
+    span->screen_end = end - QPoint(0, scrollback_height);
+    return true;
+}
 
-    bool started_in_scrollback = false;
-    if (size_t(start.y()) < m_scrollback->height()) {
-        started_in_scrollback = true;
-        QPoint end_scrollback = end;
-        if (size_t(end.y()) >= m_scrollback->height()) {
-            end_scrollback = QPoint(m_width, m_scrollback->height() - 1);
+// Hands segment every selected block on screen, in order, with the range of
+// its text that is selected.
+template <typename Segment>
+void ScreenData::walk_screen_selection(const QPoint &start, const QPoint &end, Segment segment)
+{
+    auto it = it_for_row(start.y());
+    if (it == m_screen_blocks.end())
+        return;
+    size_t screen_index = (*it)->screenIndex();
+    int start_pos = (start.y() - (*it)->screenIndex()) * m_width + start.x();
+    for (; it != m_screen_blocks.end(); ++it, start_pos = 0) {
+        const int size = (*it)->textSize();
+        int end_pos = size;
+        bool should_break = false;
+        if (size_t(screen_index + (*it)->lineCount()) > size_t(end.y())) {
+            end_pos = std::min<int>(size, (end.y() - screen_index) * m_width + end.x());
+            should_break = true;
         }
-        to_clip_board_buffer = m_scrollback->selection(start, end_scrollback);
+        segment(*it, std::min(start_pos, end_pos), end_pos);
+        if (should_break)
+            break;
+        screen_index += (*it)->lineCount();
     }
+}
 
-    if (size_t(end.y()) >= m_scrollback->height()) {
-        QPoint start_in_screen;
-        if (started_in_scrollback) {
-            start_in_screen = QPoint(0,0);
-        } else {
-            start_in_screen = start;
-            start_in_screen.ry() -= m_scrollback->height();
-        }
-        QPoint end_in_screen = end;
-        end_in_screen.ry() -= m_scrollback->height();
-
-        auto it = it_for_row(start_in_screen.y());
-        size_t screen_index = (*it)->screenIndex();
-        int start_pos = (start_in_screen.y() - (*it)->screenIndex()) * m_width + start_in_screen.x();
-        for (; it != m_screen_blocks.end(); ++it, start_pos = 0) {
-            int end_pos = (*it)->textSize();
-            bool should_break = false;
-            if (size_t(screen_index + (*it)->lineCount()) > size_t(end_in_screen.y())) {
-                end_pos = (end_in_screen.y() - screen_index) * m_width + end_in_screen.x();
-                should_break = true;
-            }
-            if (to_clip_board_buffer.size())
-                to_clip_board_buffer += '\n';
-            to_clip_board_buffer += (*it)->textLine().mid(start_pos, end_pos - start_pos);
-            if (should_break)
-                break;
-            screen_index += (*it)->lineCount();
-        }
+void ScreenData::append_screen_selection(QString *out, const QPoint &start, const QPoint &end)
+{
+    int size = out->size();
+    bool first = true;
+    walk_screen_selection(start, end, [&](Block *, int start_pos, int end_pos) {
+        size += end_pos - start_pos + (first ? 0 : 1);
+        first = false;
+    });
+    out->reserve(size);
+
+    first = true;
+    walk_screen_selection(start, end, [&](Block *block, int start_pos, int end_pos) {
+        if (!first)
+            out->append(QChar('\n'));
+        first = false;
+        block->appendText(out, start_pos, end_pos);
+    });
+}
+
+QString ScreenData::selection(const QPoint &start, const QPoint &end)
+{
+    QString selection;
+    SelectionSpan span;
+    if (!selection_span(start, end, &span))
+        return selection;
+
+    if (span.in_scrollback) {
+        // One more for the newline before the part on screen, which makes
+        // room for itself.
+        selection.reserve(m_scrollback->selectionSize(start, span.scrollback_end) + 1);
+        m_scrollback->appendSelection(&selection, start, span.scrollback_end);
+        if (span.on_screen)
+            selection.append(QChar('\n'));
     }
-    QGuiApplication::clipboard()->setText(to_clip_board_buffer, mode);
+    if (span.on_screen)
+        append_screen_selection(&selection, span.screen_start, span.screen_end);
+    return selection;
+}
+
+bool ScreenData::writeSelection(const QPoint &start, const QPoint &end, QIODevice *device)
+{
+    SelectionSpan span;
+    if (!selection_span(start, end, &span))
+        return true;
+
+    if (span.in_scrollback && !m_scrollback->writeSelection(start, span.scrollback_end, device))
+        return false;
+    if (!span.on_screen)
+        return true;
+
+    QString screen_text;
+    if (span.in_scrollback)
+        screen_text.append(QChar('\n'));
+    append_screen_selection(&screen_text, span.screen_start, span.screen_end);
+    if (device->write(screen_text.toUtf8()) < 0) {
+        qCWarning(lcScreenData) << "Could not write selection:" << device->errorString();
+        return false;
+    }
+    return true;
+}
+
+void ScreenData::sendSelectionToClipboard(const QPoint &start, const QPoint &end, QClipboard::Mode mode)
+{
+    if (start.y() < 0)
+        return;
+    if (end.y() >= contentHeight())
+        return;
+
+    QGuiApplication::clipboard()->setText(selection(start, end), mode);
 }
 
 const SelectionRange ScreenData::getDoubleClickSelectionRange(size_t character, size_t line)
@@ -383,7 +583,7 @@ const SelectionRange ScreenData::getDoubleClickSelectionRange(size_t character,
     return { QPoint(), QPoint() };
 }
 
-const CursorDiff ScreenData::modify(const QPoint &point, const QString &text, const TextStyle &style, bool replace, bool only_latin)
+const CursorDiff ScreenData::modify(const QPoint &point, const QString &text, quint16 style, bool replace, bool only_latin)
 {
     auto it = it_for_row(point.y());
     if (it == m_screen_blocks.end())
@@ -395,6 +595,8 @@ const CursorDiff ScreenData::modify(const QPoint &point, const QString &text, co
         block->lineCountAfterModified(start_char, text.size(), replace)  - lines_before;
     const size_t old_content_height = contentHeight();
     m_height += lines_changed;
+    if (lines_changed)
+        invalidate_row_index();
     if (lines_changed > 0) {
         int removed = 0;
         auto to_merge_inn = it;
@@ -441,6 +643,7 @@ void ScreenData::clearBlock(std::list<Block *>::iterator line)
     (*line)->clear();
     int diff_line = before_count - (*line)->lineCount();
     if (diff_line > 0) {
+        invalidate_row_index();
         ++line;
         for (int i = 0; i < diff_line; i++) {
             m_screen_blocks.insert(line, new Block(m_screen));
@@ -472,6 +675,8 @@ std::list<Block *>::iterator ScreenData::split_out_row_from_block(std::list<Bloc
     if (row_in_block == 0 && lines == 1)
         return it;
 
+    invalidate_row_index();
+
     if (row_in_block == 0) {
         auto insert_before = (*it)->takeLine(0);
         insert_before->setScreenIndex(row_in_block);
@@ -497,6 +702,12 @@ int ScreenData::push_at_most_to_scrollback(int lines)
 {
     if (lines >= m_height)
         lines = m_height - 1;
+    // Blocks pushed out before the next dispatch never get Text segments or
+    // events, as only the blocks in view are dispatched. In fast scroll mode,
+    // once more than a screenful has been pushed since the last dispatch, the
+    // blocks leaving now have never been shown either, so their cells are
+    // squeezed and their display caches dropped until their page is sealed.
+    const bool compact = m_screen->fastScroll() && m_scrollback->maxSize();
     int pushed = 0;
     auto it = m_screen_blocks.begin();
     while (it != m_screen_blocks.end() && pushed + (*it)->lineCount() <= lines) {
@@ -504,9 +715,16 @@ int ScreenData::push_at_most_to_scrollback(int lines)
         const int block_height = (*it)->lineCount();
         m_height -= block_height;
         pushed += block_height;
-        m_scrollback->addBlock(*it);
-        it = m_screen_blocks.erase(it);
+        m_pushed_since_dispatch += block_height;
+        row_index_pop_front(block_height);
+        if (compact && m_pushed_since_dispatch > m_screen_height)
+            (*it)->compact();
+        ++it;
     }
+
+    std::list<Block *> evicted;
+    evicted.splice(evicted.end(), m_screen_blocks, m_screen_blocks.begin(), it);
+    m_scrollback->addBlocks(&evicted);
     return pushed;
 }
 
@@ -519,6 +737,7 @@ int ScreenData::reclaim_at_least(int lines)
         lines_reclaimed += block->lineCount();
         m_block_count++;
         m_screen_blocks.push_front(block);
+        invalidate_row_index();
     }
     return lines_reclaimed;
 }
@@ -533,6 +752,7 @@ int ScreenData::remove_lines_from_end(int lines)
         if (removed + block_height <= lines) {
             removed += block_height;
             m_height -= block_height;
+            m_row_index_lines -= block_height;
             m_block_count--;
             delete (*it);
             it = m_screen_blocks.erase(it);
@@ -540,6 +760,7 @@ int ScreenData::remove_lines_from_end(int lines)
             const int to_remove = lines - removed;
             removed += to_remove;
             m_height -= to_remove;
+            m_row_index_lines -= to_remove;
             Block *block = *it;
             for (int i = 0; i < to_remove; i++) {
                 block->removeLine(block->lineCount()-1);
@@ -562,6 +783,7 @@ int ScreenData::ensure_at_least_height(int height)
         int to_insert = height - m_height;
         for (int i = 0; i < to_insert; i++) {
             m_screen_blocks.push_back(new Block(m_screen));
+            row_index_insert(m_row_index_lines, --m_screen_blocks.end(), 1);
         }
         qCDebug(lcScreenData) << "Inserted " << to_insert << "new blocks";
         m_height += to_insert;
@@ -577,9 +799,118 @@ int ScreenData::ensure_at_least_height(int height)
     }
 }
 
+// The scrollback only reflows what is on screen when the width changes.
+// The rest is done a slice at a time from the event loop, so that dragging
+// the window edge does not reflow the whole history every step.
+void ScreenData::schedule_reflow()
+{
+    if (m_reflow_scheduled || !m_scrollback->reflowPending())
+        return;
+    m_reflow_scheduled = true;
+    QTimer::singleShot(0, this, &ScreenData::continue_reflow);
+}
+
+void ScreenData::continue_reflow()
+{
+    m_reflow_scheduled = false;
+    const size_t old_height = m_scrollback->height();
+    m_scrollback->reflow(screen()->height(), reflowSliceTime);
+    // The screen lines moved along with the end of the scrollback.
+    if (m_scrollback->height() != old_height)
+        m_screen->scheduleEventDispatch();
+    schedule_reflow();
+}
+
 int ScreenData::content_height_diff(size_t old_content_height)
 {
     const size_t content_height = contentHeight();
     return old_content_height < content_height ? content_height - old_content_height :
         - int(old_content_height - content_height);
 }
+
+void ScreenData::rebuild_row_index()
+{
+    int lines = 0;
+    for (Block *block : m_screen_blocks)
+        lines += block->lineCount();
+
+    // Leave room for a line being appended before the next rebuild.
+    const int capacity = std::max(lines, m_screen_height) + 1;
+    if (m_row_index.size() < capacity)
+        m_row_index.resize(capacity);
+
+    m_row_index_head = 0;
+    m_row_index_lines = 0;
+    for (auto it = m_screen_blocks.begin(); it != m_screen_blocks.end(); ++it) {
+        const int block_lines = (*it)->lineCount();
+        for (int i = 0; i < block_lines; i++)
+            m_row_index[m_row_index_lines++] = { it, i };
+    }
+    m_row_index_valid = true;
+}
+
+void ScreenData::row_index_pop_front(int lines)
+{
+    if (!m_row_index_valid)
+        return;
+    m_row_index_head = row_index_pos(lines);
+    m_row_index_lines -= lines;
+}
+
+void ScreenData::row_index_insert(int line, std::list<Block *>::iterator first, int count)
+{
+    if (!m_row_index_valid)
+        return;
+    if (line < 0 || line > m_row_index_lines || m_row_index_lines + count > m_row_index.size()) {
+        invalidate_row_index();
+        return;
+    }
+
+    for (int i = m_row_index_lines - 1; i >= line; i--)
+        m_row_index[row_index_pos(i + count)] = m_row_index.at(row_index_pos(i));
+    m_row_index_lines += count;
+
+    // Inserted blocks are always fresh single line blocks.
+    for (int i = 0; i < count; i++, ++first)
+        m_row_index[row_index_pos(line + i)] = { first, 0 };
+}
+
+void ScreenData::row_index_remove(int line, int count)
+{
+    if (!m_row_index_valid)
+        return;
+    if (line < 0 || line + count > m_row_index_lines) {
+        invalidate_row_index();
+        return;
+    }
+
+    for (int i = line; i + count < m_row_index_lines; i++)
+        m_row_index[row_index_pos(i)] = m_row_index.at(row_index_pos(i + count));
+    m_row_index_lines -= count;
+}
+
+void ScreenData::row_index_move(int from_line, int to_line, int count)
+{
+    if (!m_row_index_valid)
+        return;
+    if (from_line < 0 || to_line < 0
+            || std::max(from_line, to_line) + count > m_row_index_lines) {
+        invalidate_row_index();
+        return;
+    }
+
+    // Moving the lines is a rotation of the range they move over, done in
+    // place as three reversals so that scrolling does not allocate.
+    const int first = std::min(from_line, to_line);
+    const int last = std::max(from_line, to_line) + count;
+    const int middle = from_line < to_line ? from_line + count : from_line;
+    row_index_reverse(first, middle);
+    row_index_reverse(middle, last);
+    row_index_reverse(first, last);
+}
+
+void ScreenData::row_index_reverse(int from_line, int to_line)
+{
+    for (int i = from_line, j = to_line - 1; i < j; i++, j--)
+        std::swap(m_row_index[row_index_pos(i)], m_row_index[row_index_pos(j)]);
+}
@@ -36,6 +36,7 @@
 #include <QtCore/QDebug>
 class Screen;
 class Scrollback;
+class QIODevice;
 
 class CursorDiff
 {
@@ -53,6 +54,11 @@ public:
 
     int contentHeight() const;
 
+    void setScrollbackLimits(size_t max_lines, size_t memory_limit, bool spill);
+    size_t scrollbackHeight() const;
+    size_t scrollbackMemory() const;
+    qint64 scrollbackSpillFileSize() const;
+
     void clearToEndOfLine(const QPoint &pos);
     void clearToEndOfScreen(int y);
     void clearToBeginningOfLine(const QPoint &pos);
@@ -60,15 +66,18 @@ public:
     void clearLine(const QPoint &pos);
     void clear();
     void releaseTextObjects();
+    void markLiveStyles(QBitArray *live) const;
+    void markLiveClusters(QBitArray *live) const;
+    void attachToPreviousCell(const QPoint &pos, const QString &text);
 
     void clearCharacters(const QPoint &pos, int to);
     void deleteCharacters(const QPoint &pos, int to);
 
-    const CursorDiff replace(const QPoint &pos, const QString &text, const TextStyle &style, bool only_latin);
-    const CursorDiff insert(const QPoint &pos, const QString &text, const TextStyle &style, bool only_latin);
+    const CursorDiff replace(const QPoint &pos, const QString &text, quint16 style, bool only_latin);
+    const CursorDiff insert(const QPoint &pos, const QString &text, quint16 style, bool only_latin);
 
-    void moveLine(int from, int to);
-    void insertLine(int insertAt, int topMargin);
+    void moveLines(int from, int to, int count);
+    void insertLines(int insertAt, int topMargin, int count);
 
     void fill(const QChar &character);
 
@@ -81,6 +90,8 @@ public:
 
     void ensureVisibleLines(int top_line);
 
+    QString selection(const QPoint &start, const QPoint &end);
+    bool writeSelection(const QPoint &start, const QPoint &end, QIODevice *device);
     void sendSelectionToClipboard(const QPoint &start, const QPoint &end, QClipboard::Mode mode);
 
     inline std::list<Block *>::iterator it_for_row(int row);
@@ -96,7 +107,7 @@ signals:
     void dataSizeChanged(int newWidth, int newHeight, int removedBeginning, int reclaimed);
 
 private:
-    const CursorDiff modify(const QPoint &pos, const QString &text, const TextStyle &style, bool replace, bool only_latin);
+    const CursorDiff modify(const QPoint &pos, const QString &text, quint16 style, bool replace, bool only_latin);
     void clearBlock(std::list<Block *>::iterator line);
     std::list<Block *>::iterator it_for_row_ensure_single_line_block(int row);
     std::list<Block *>::iterator split_out_row_from_block(std::list<Block *>::iterator block_it, int row_in_block);
@@ -105,6 +116,40 @@ private:
     int remove_lines_from_end(int lines);
     int ensure_at_least_height(int height);
     int content_height_diff(size_t old_content_height);
+    void schedule_reflow();
+    void continue_reflow();
+
+    struct SelectionSpan {
+        bool in_scrollback;
+        bool on_screen;
+        QPoint scrollback_end;
+        QPoint screen_start;
+        QPoint screen_end;
+    };
+    bool selection_span(const QPoint &start, const QPoint &end, SelectionSpan *span);
+    template <typename Segment>
+    void walk_screen_selection(const QPoint &start, const QPoint &end, Segment segment);
+    void append_screen_selection(QString *out, const QPoint &start, const QPoint &end);
+
+    // The row index is a ring of one entry per line in m_screen_blocks, so
+    // that finding the block for a row does not walk the list. Dropping lines
+    // off the top only moves the ring, and scrolling shifts the entries below
+    // the affected rows. Any other structural change invalidates it until the
+    // next lookup.
+    struct RowIndexEntry {
+        std::list<Block *>::iterator block;
+        int line_in_block;
+    };
+    inline int row_index_pos(int line) const;
+    int row_index_line(int row) const { return row - m_screen_height + m_row_index_lines; }
+    void rebuild_row_index();
+    void invalidate_row_index() { m_row_index_valid = false; }
+    void row_index_pop_front(int lines);
+    void row_index_insert(int line, std::list<Block *>::iterator first, int count);
+    void row_index_remove(int line, int count);
+    void row_index_move(int from_line, int to_line, int count);
+    void row_index_reverse(int from_line, int to_line);
+
     Screen *m_screen;
     Scrollback *m_scrollback;
     int m_screen_height;
@@ -112,35 +157,61 @@ private:
     int m_width;
     int m_block_count;
     int m_old_total_lines;
+    int m_pushed_since_dispatch;
+    bool m_reflow_scheduled;
 
     std::list<Block *> m_screen_blocks;
+
+    QVector<RowIndexEntry> m_row_index;
+    int m_row_index_head;
+    int m_row_index_lines;
+    bool m_row_index_valid;
 };
 
+int ScreenData::row_index_pos(int line) const
+{
+    int pos = m_row_index_head + line;
+    if (pos >= m_row_index.size())
+        pos -= m_row_index.size();
+    return pos;
+}
+
 std::list<Block *>::iterator ScreenData::it_for_row(int row)
 {
     if (row >= m_screen_height) {
         return m_screen_blocks.end();
     }
-    auto it = m_screen_blocks.end();
-    int line_for_block = m_screen_height;
-    size_t abs_line = contentHeight();
-    while (it != m_screen_blocks.begin()) {
-        --it;
-        line_for_block -= (*it)->lineCount();
-        abs_line -= (*it)->lineCount();
-        if (line_for_block <= row) {
-            (*it)->setScreenIndex(line_for_block);
-            (*it)->setLine(abs_line);
-            return it;
-        }
-    }
+    if (!m_row_index_valid)
+        rebuild_row_index();
 
-    return m_screen_blocks.end();
+    const int line = row_index_line(row);
+    if (line < 0 || line >= m_row_index_lines)
+        return m_screen_blocks.end();
+
+    const RowIndexEntry &entry = m_row_index.at(row_index_pos(line));
+    const int first_line = line - entry.line_in_block;
+    (*entry.block)->setScreenIndex(row - entry.line_in_block);
+    (*entry.block)->setLine(contentHeight() - m_row_index_lines + first_line);
+    return entry.block;
 }
+
 inline std::list<Block *>::iterator ScreenData::it_for_block(Block *block)
 {
     if (!block)
         return m_screen_blocks.end();
+
+    // The screen index from the last lookup is usually still correct.
+    if (!m_row_index_valid)
+        rebuild_row_index();
+    const int line = row_index_line(block->screenIndex());
+    if (line >= 0 && line < m_row_index_lines) {
+        const RowIndexEntry &entry = m_row_index.at(row_index_pos(line));
+        if (*entry.block == block && entry.line_in_block == 0) {
+            block->setLine(contentHeight() - m_row_index_lines + line);
+            return entry.block;
+        }
+    }
+
     auto it = m_screen_blocks.end();
     int line_for_block = m_screen_height;
     size_t abs_line = contentHeight();
@@ -156,4 +227,5 @@ inline std::list<Block *>::iterator ScreenData::it_for_block(Block *block)
     }
     return m_screen_blocks.end();
 }
+
 #endif // SCREENDATA_H
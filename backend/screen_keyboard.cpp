@@ -31,7 +31,6 @@
 #include "selection.h"
 
 #include "controll_chars.h"
-#include "character_sets.h"
 
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
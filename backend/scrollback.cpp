@@ -27,52 +27,249 @@
 #include "screen.h"
 #include "block.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QDir>
+#include <QtCore/QIODevice>
 
 Q_LOGGING_CATEGORY(lcScrollback, "yat.scrollback", QtWarningMsg)
 
-Scrollback::Scrollback(size_t max_size)
-    : m_height(0)
+// Blocks per compressed page. Small enough that inflating a page to show a
+// screenful is cheap, big enough for zlib to find the repetition.
+static const int pageBlocks = 128;
+
+// Dead space in the spill file that is always tolerated, so that small
+// files are not compacted over and over.
+static const qint64 spillCompactionMinimum = 64 * 1024;
+
+// Characters converted to UTF-8 at a time when writing out a selection.
+static const int selectionWriteChunk = 64 * 1024;
+
+template <typename T>
+static void put(char *&dst, T value)
+{
+    memcpy(dst, &value, sizeof(T));
+    dst += sizeof(T);
+}
+
+template <typename T>
+static T take(const char *&src)
+{
+    T value;
+    memcpy(&value, src, sizeof(T));
+    src += sizeof(T);
+    return value;
+}
+
+// A block is stored as its only_latin flag, the style ids as (id, length)
+// runs and then the UTF-16 text. Keeping text and styles apart lets both
+// compress well.
+static void appendBlock(QByteArray *data, Block *block)
+{
+    const QVector<TextCell> &cells = block->cells();
+    quint32 runs = 0;
+    for (int i = 0; i < cells.size(); i++) {
+        if (i == 0 || cells.at(i).style != cells.at(i - 1).style)
+            runs++;
+    }
+
+    const int offset = data->size();
+    data->resize(offset + sizeof(quint8) + sizeof(quint32)
+                 + runs * (sizeof(quint16) + sizeof(quint32))
+                 + cells.size() * sizeof(quint16));
+    char *dst = data->data() + offset;
+    put<quint8>(dst, block->onlyLatin());
+    put<quint32>(dst, runs);
+    for (int start = 0; start < cells.size();) {
+        const quint16 style = cells.at(start).style;
+        int end = start + 1;
+        while (end < cells.size() && cells.at(end).style == style)
+            end++;
+        put<quint16>(dst, style);
+        put<quint32>(dst, end - start);
+        start = end;
+    }
+    for (int i = 0; i < cells.size(); i++)
+        put<quint16>(dst, cells.at(i).character.unicode());
+}
+
+// One entry per style run and cluster; seal() sorts out the duplicates.
+static void appendIds(QVector<quint16> *styles, QVector<ushort> *clusters, Block *block)
+{
+    const QVector<TextCell> &cells = block->cells();
+    for (int i = 0; i < cells.size(); i++) {
+        if (i == 0 || cells.at(i).style != cells.at(i - 1).style)
+            styles->append(cells.at(i).style);
+    }
+    if (block->onlyLatin())
+        return;
+    for (const TextCell &cell : cells) {
+        if (ClusterTable::isCluster(cell.character))
+            clusters->append(cell.character.unicode());
+    }
+}
+
+template <typename T>
+static void sortUnique(QVector<T> *ids)
+{
+    std::sort(ids->begin(), ids->end());
+    ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+}
+
+// What a block costs while it is kept as a Block.
+static size_t blockMemory(Block *block)
+{
+    return sizeof(Block) + block->cells().capacity() * sizeof(TextCell);
+}
+
+static void skipBlock(const char *&src, int size)
+{
+    src += sizeof(quint8);
+    const quint32 runs = take<quint32>(src);
+    src += runs * (sizeof(quint16) + sizeof(quint32)) + size * sizeof(quint16);
+}
+
+static void readBlock(const char *&src, int size, QVector<TextCell> *cells, bool *only_latin)
+{
+    cells->resize(size);
+    TextCell *cell = cells->data();
+    *only_latin = take<quint8>(src);
+    const quint32 runs = take<quint32>(src);
+    int pos = 0;
+    for (quint32 i = 0; i < runs; i++) {
+        const quint16 style = take<quint16>(src);
+        const quint32 length = take<quint32>(src);
+        for (quint32 j = 0; j < length && pos < size; j++)
+            cell[pos++].style = style;
+    }
+    for (int i = 0; i < size; i++)
+        cell[i].character = QChar(take<quint16>(src));
+}
+
+Scrollback::Scrollback(size_t max_size, Screen *screen)
+    : m_screen(screen)
+    , m_height(0)
     , m_width(0)
+    , m_stale_pages(0)
     , m_block_count(0)
     , m_max_size(max_size)
+    , m_memory_limit(0)
+    , m_memory(0)
+    , m_spill_file(nullptr)
+    , m_spilled_pages(0)
+    , m_spill_live(0)
+    , m_spill_enabled(false)
     , m_firstVisibleLine(0)
+    , m_visible_from(0)
+    , m_visible_to(0)
+{
+}
+
+Scrollback::~Scrollback()
 {
+    for (Page &page : m_pages) {
+        for (Block *block : page.blocks)
+            delete block;
+    }
+    delete m_spill_file;
 }
 
-void Scrollback::addBlock(Block *block)
+// Takes ownership of all of blocks, oldest first, trimming the scrollback
+// to size once rather than after every block.
+void Scrollback::addBlocks(std::list<Block *> *blocks)
 {
+    if (blocks->empty())
+        return;
+
     if (!m_max_size) {
-        delete block;
+        for (Block *block : *blocks)
+            delete block;
+        blocks->clear();
         return;
     }
 
-    qCDebug(lcScrollback) << "Adding block " << block;
-    m_blocks.push_back(block);
-    block->releaseTextObjects();
-    m_block_count++;
-    m_height += m_blocks.back()->lineCount();
+    qCDebug(lcScrollback) << "Adding" << blocks->size() << "blocks";
+    if (!m_width)
+        m_width = blocks->front()->width();
 
-    while (m_blocks.front() != block && m_height - m_blocks.front()->lineCount() >= m_max_size) {
-        qCDebug(lcScrollback) << "Popping excess block " << block;
-        m_block_count--;
-        m_height -= std::min(m_blocks.front()->lineCount(), (int)m_height);
-        delete m_blocks.front();
-        m_blocks.pop_front();
+    for (Block *block : *blocks) {
+        block->releaseTextObjects();
+        if (m_pages.empty() || m_pages.back().sealed) {
+            const size_t start = m_pages.empty() ? 0 : m_pages.back().start + m_pages.back().height;
+            m_pages.emplace_back();
+            m_pages.back().start = start;
+            m_pages.back().width = m_width;
+        }
+        Page &page = m_pages.back();
+        reflowPage(page);
+        const int lines = block->lineCount();
+        page.blocks.push_back(block);
+        page.sizes.append(block->textSize());
+        page.count++;
+        page.height += lines;
+        page.memory += blockMemory(block);
+        m_block_count++;
+        m_height += lines;
+        m_memory += blockMemory(block);
+
+        if (page.count == pageBlocks) {
+            seal(page);
+            if (!page.visible)
+                deflate(page);
+        }
     }
+    blocks->clear();
+
+    trim();
 }
 
 Block *Scrollback::reclaimBlock()
 {
-    if (m_blocks.empty())
+    if (m_pages.empty())
         return nullptr;
 
-    Block *last = m_blocks.back();
+    Page &page = m_pages.back();
+    reflowPage(page);
+    inflate(page);
+
+    // The page is about to change, so its compressed copy is stale.
+    if (page.sealed) {
+        page.dropped = 0;
+        page.data.clear();
+        page.sealed = false;
+        if (page.spill_offset >= 0)
+            releaseSpilled(page);
+        m_memory -= page.memory;
+        page.memory = 0;
+        page.sizes.clear();
+        page.styles.clear();
+        page.clusters.clear();
+        for (Block *block : page.blocks) {
+            page.sizes.append(block->textSize());
+            page.memory += blockMemory(block);
+        }
+        page.count = page.sizes.size();
+        m_memory += page.memory;
+    }
+
+    Block *last = page.blocks.back();
     qCDebug(lcScrollback) << "Reclaiming block " << last;
+    page.blocks.pop_back();
+    page.sizes.removeLast();
+    page.count--;
+    page.height -= last->lineCount();
+    page.memory -= blockMemory(last);
+    m_memory -= blockMemory(last);
     last->setWidth(m_width);
     m_block_count--;
     m_height -= last->lineCount();
-    m_blocks.pop_back();
+    if (page.blocks.empty())
+        m_pages.pop_back();
 
     return last;
 }
@@ -106,6 +303,9 @@ Block *Scrollback::reclaimBlock()
 // Note, note, note! One must be careful with the concept of "lines". As
 // indicated in the diagrams above, we are dealing with blocks, which may
 // actually represent multiple lines on screen (soft-wrapped).
+//
+// Blocks only exist for pages in the viewport; pages that scroll out of it
+// are deflated again in fixupVisibility().
 void Scrollback::ensureVisibleLines(int screenHeight, int top_line)
 {
     if (top_line < 0)
@@ -113,37 +313,69 @@ void Scrollback::ensureVisibleLines(int screenHeight, int top_line)
     if (size_t(top_line) >= m_height)
         return;
 
-    // Hide old lines.
-    // TODO: optimize to *only* hide the range that top_line -> top_line + height &
-    // m_firstVisibleLine -> m_firstVisibleLine + height do not intersect.
-    std::list<Block*>::iterator it = findIteratorForLine(m_firstVisibleLine);
-    int lastVisibleLine = m_firstVisibleLine + screenHeight;
-    int line_no = m_firstVisibleLine;
-    while (it != m_blocks.end() && line_no <= lastVisibleLine) {
-        Block *b = *it;
-        qCDebug(lcScrollback) << "Releasing scrollback block starting " << line_no;
-        b->releaseTextObjects();
-        line_no += b->lineCount();
-        it++;
+    // Hide the lines that leave. Their Text objects go back to the Screen,
+    // which hands them out again to the lines coming in when
+    // fixupVisibility() dispatches them. Lines in both viewports keep their
+    // text and line number, so dispatching them does nothing.
+    const size_t first = m_firstVisibleLine;
+    const size_t last = first + screenHeight;
+    const size_t new_first = top_line;
+    const size_t new_last = new_first + screenHeight;
+    const size_t base = firstPosition();
+    for (auto page = pageForLine(first); page != m_pages.end() && page->start - base <= last; ++page) {
+        size_t line_no = page->start - base;
+        for (Block *b : page->blocks) {
+            const size_t block_end = line_no + b->lineCount();
+            if (block_end > first && line_no <= last
+                    && !(block_end > new_first && line_no <= new_last)) {
+                qCDebug(lcScrollback) << "Releasing scrollback block starting " << line_no;
+                b->releaseTextObjects();
+            }
+            line_no = block_end;
+        }
     }
 
     m_firstVisibleLine = top_line;
     fixupVisibility(screenHeight);
 }
 
-// Fix line numbers for blocks in the viewport.
+// Fix line numbers for blocks in the viewport, inflating the pages it
+// covers and deflating the ones it left.
 void Scrollback::fixupVisibility(int screenHeight)
 {
-    std::list<Block*>::iterator it = findIteratorForLine(m_firstVisibleLine);
-    int lastVisibleLine = m_firstVisibleLine + screenHeight;
-    int line_no = m_firstVisibleLine;
-    while (it != m_blocks.end() && line_no <= lastVisibleLine) {
-        qCDebug(lcScrollback) << "Showing scrollback block starting " << line_no;
-        Block *b = *it;
-        b->setLine(line_no);
-        b->dispatchEvents();
-        line_no += b->lineCount();
-        it++;
+    const size_t first = m_firstVisibleLine;
+    const size_t last = first + screenHeight;
+    reflowLines(first, last);
+    const size_t base = firstPosition();
+
+    // Dropping lines can move the front page past m_visible_to, so the run
+    // also goes on for as long as pages are marked visible.
+    for (auto page = pageAt(m_visible_from);
+         page != m_pages.end() && (page->start < m_visible_to || page->visible); ++page) {
+        const size_t page_start = page->start - base;
+        if (page->visible && (page_start + page->height <= first || page_start > last)) {
+            deflate(*page);
+            page->visible = false;
+        }
+    }
+
+    m_visible_from = m_visible_to = 0;
+    auto page = pageForLine(first);
+    if (page != m_pages.end())
+        m_visible_from = page->start;
+    for (; page != m_pages.end() && page->start - base <= last; ++page) {
+        inflate(*page);
+        size_t line_no = page->start - base;
+        for (Block *b : page->blocks) {
+            if (line_no + b->lineCount() > first && line_no <= last) {
+                qCDebug(lcScrollback) << "Showing scrollback block starting " << line_no;
+                b->setLine(line_no);
+                b->dispatchEvents();
+            }
+            line_no += b->lineCount();
+        }
+        page->visible = true;
+        m_visible_to = page->start + page->height;
     }
 }
 
@@ -152,79 +384,591 @@ size_t Scrollback::height() const
     return m_height;
 }
 
+qint64 Scrollback::spillFileSize() const
+{
+    return m_spill_file ? m_spill_file->size() : 0;
+}
+
+void Scrollback::markLiveStyles(QBitArray *live) const
+{
+    for (const Page &page : m_pages) {
+        for (quint16 style : page.styles)
+            live->setBit(style);
+        for (Block *block : page.blocks)
+            block->markLiveStyles(live);
+    }
+}
+
+void Scrollback::markLiveClusters(QBitArray *live) const
+{
+    for (const Page &page : m_pages) {
+        for (ushort cluster : page.clusters)
+            ClusterTable::markLive(live, QChar(cluster));
+        for (Block *block : page.blocks)
+            block->markLiveClusters(live);
+    }
+}
+
+void Scrollback::setMaxSize(size_t max_size)
+{
+    m_max_size = max_size;
+    if (!m_max_size) {
+        while (!m_pages.empty())
+            dropOldestPage();
+        return;
+    }
+    trim();
+}
+
+void Scrollback::setMemoryLimit(size_t bytes)
+{
+    m_memory_limit = bytes;
+    trim();
+}
+
+void Scrollback::setSpillEnabled(bool enabled)
+{
+    if (enabled == m_spill_enabled)
+        return;
+    m_spill_enabled = enabled;
+    if (!m_spill_enabled) {
+        // What was spilled was over the memory limit, so it goes.
+        while (m_spilled_pages)
+            dropOldestPage();
+        delete m_spill_file;
+        m_spill_file = nullptr;
+        m_spill_live = 0;
+    }
+    trim();
+}
+
 void Scrollback::setWidth(int screenHeight, int width)
 {
+    const size_t old_width = std::max<size_t>(m_width, 1);
     m_width = width;
     m_height = 0;
+    m_stale_pages = 0;
 
-    // Update length of all blocks so line numbers are correct.
-    for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it) {
-        Block *b = *it;
-        b->setWidth(m_width);
-        m_height += b->lineCount();
+    // Until a page is reflowed, assume its lines wrap in proportion to the
+    // width, but each block takes at least one.
+    for (Page &page : m_pages) {
+        page.start = m_height;
+        if (page.width != width) {
+            const size_t estimate = page.height * (page.width ? page.width : old_width) / std::max(width, 1);
+            page.height = std::max(estimate, size_t(page.count - page.dropped));
+            page.width = 0;
+            m_stale_pages++;
+        }
+        m_height += page.height;
     }
 
-    // And make sure the blocks visible are correct.
+    // And make sure the blocks visible are correct. Every position moved, so
+    // all pages are checked.
+    m_visible_from = 0;
+    m_visible_to = m_height;
     fixupVisibility(screenHeight);
 }
 
-QString Scrollback::selection(const QPoint &start, const QPoint &end) const
+// Reflows stale pages, newest first, until msecs have passed. Returns
+// whether there are more left.
+bool Scrollback::reflow(int screenHeight, int msecs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    bool moved = false;
+    for (auto page = m_pages.rbegin(); page != m_pages.rend() && m_stale_pages; ++page) {
+        if (size_t(page->width) == m_width)
+            continue;
+        moved |= reflowPage(*page);
+        if (timer.elapsed() >= msecs)
+            break;
+    }
+    qCDebug(lcScrollback) << "Reflowed for" << timer.elapsed() << "ms," << m_stale_pages << "pages left";
+
+    if (moved) {
+        updatePositions();
+        fixupVisibility(screenHeight);
+    }
+    return m_stale_pages;
+}
+
+// Reflows the selected lines, and clamps end if that left fewer lines than
+// the selection was made on. Returns false if nothing is left to select.
+bool Scrollback::prepareSelection(const QPoint &start, QPoint *end)
 {
     Q_ASSERT(start.y() >= 0);
-    Q_ASSERT(end.y() >= 0);
-    Q_ASSERT(size_t(end.y()) < m_height);
+    Q_ASSERT(end->y() >= 0);
+
+    reflowLines(start.y(), end->y());
+    if (size_t(end->y()) >= m_height) {
+        if (size_t(start.y()) >= m_height)
+            return false;
+        *end = QPoint(m_width, m_height - 1);
+    }
+    return true;
+}
+
+// Hands segment every selected block, oldest first, with the range of its
+// text that is selected. Without with_text only the sizes are looked at and
+// the block is null, so measuring does not inflate anything.
+template <typename Segment>
+void Scrollback::walkSelection(const QPoint &start, const QPoint &end, bool with_text, Segment segment)
+{
+    const size_t start_line = start.y();
+    const size_t end_line = end.y();
+
+    for (auto page = pageForLine(start_line); page != m_pages.end(); ++page) {
+        size_t line = page->start - firstPosition();
+        if (line > end_line)
+            break;
+
+        const bool was_inflated = !page->blocks.empty();
+        if (with_text)
+            inflate(*page);
+        const QVector<int> &sizes = page->sizes;
+
+        auto it = page->blocks.begin();
+        for (int i = page->dropped; i < page->count && line <= end_line; i++) {
+            Block *block = page->blocks.empty() ? nullptr : *it++;
+            const int size = block ? block->textSize() : sizes.at(i);
+            const size_t next_line = line + linesForSize(size);
+            if (next_line > start_line) {
+                int start_pos = 0;
+                if (line <= start_line)
+                    start_pos = (start_line - line) * m_width + start.x();
+                int end_pos = size;
+                if (next_line > end_line)
+                    end_pos = std::min<int>(size, (end_line - line) * m_width + end.x());
+                start_pos = std::min(start_pos, end_pos);
+                segment(with_text ? block : nullptr, start_pos, end_pos);
+            }
+            line = next_line;
+        }
+
+        if (with_text && !was_inflated)
+            deflate(*page);
+    }
+}
+
+QString Scrollback::selection(const QPoint &start, const QPoint &end)
+{
     QString return_string;
+    return_string.reserve(selectionSize(start, end));
+    appendSelection(&return_string, start, end);
+    return return_string;
+}
+
+size_t Scrollback::selectionSize(const QPoint &start, const QPoint &end)
+{
+    QPoint selection_end = end;
+    if (!prepareSelection(start, &selection_end))
+        return 0;
+
+    size_t size = 0;
+    bool first = true;
+    walkSelection(start, selection_end, false, [&](Block *, int start_pos, int end_pos) {
+        size += end_pos - start_pos + (first ? 0 : 1);
+        first = false;
+    });
+    return size;
+}
+
+void Scrollback::appendSelection(QString *out, const QPoint &start, const QPoint &end)
+{
+    QPoint selection_end = end;
+    if (!prepareSelection(start, &selection_end))
+        return;
+
+    bool first = true;
+    walkSelection(start, selection_end, true, [&](Block *block, int start_pos, int end_pos) {
+        if (!first)
+            out->append(QChar('\n'));
+        first = false;
+        block->appendText(out, start_pos, end_pos);
+    });
+}
+
+bool Scrollback::writeSelection(const QPoint &start, const QPoint &end, QIODevice *device)
+{
+    QPoint selection_end = end;
+    if (!prepareSelection(start, &selection_end))
+        return true;
+
+    QString buffer;
+    buffer.reserve(selectionWriteChunk + 1);
+    bool ok = true;
+    auto flush = [&]() {
+        if (ok && !buffer.isEmpty() && device->write(buffer.toUtf8()) < 0) {
+            qCWarning(lcScrollback) << "Could not write selection:" << device->errorString();
+            ok = false;
+        }
+        buffer.resize(0);
+    };
+
+    bool first = true;
+    walkSelection(start, selection_end, true, [&](Block *block, int start_pos, int end_pos) {
+        if (!ok)
+            return;
+        if (!first)
+            buffer.append(QChar('\n'));
+        first = false;
+        while (end_pos - start_pos > selectionWriteChunk - buffer.size()) {
+            // Cells never hold half a surrogate pair, so any split will do.
+            const int split = start_pos + std::max(selectionWriteChunk - buffer.size(), 0);
+            block->appendText(&buffer, start_pos, split);
+            start_pos = split;
+            flush();
+            if (!ok)
+                return;
+        }
+        block->appendText(&buffer, start_pos, end_pos);
+    });
+    flush();
+    return ok;
+}
+
+const SelectionRange Scrollback::getDoubleClickSelectionRange(size_t character, size_t line)
+{
+    reflowLines(line, line);
+    auto page = pageForLine(line);
+    if (page == m_pages.end())
+        return { QPoint(), QPoint() };
+
+    const bool was_inflated = !page->blocks.empty();
+    inflate(*page);
+
+    SelectionRange range = { QPoint(), QPoint() };
+    size_t line_no = page->start - firstPosition();
+    for (auto it = page->blocks.begin(); it != page->blocks.end(); ++it) {
+        if (line < line_no + (*it)->lineCount()) {
+            (*it)->setLine(line_no);
+            range = Selection::getDoubleClickRange(it, character, line, m_width);
+            break;
+        }
+        line_no += (*it)->lineCount();
+    }
+
+    if (!was_inflated)
+        deflate(*page);
+    return range;
+}
+
+// The page holding position, or if it was dropped, the first page after it.
+std::deque<Scrollback::Page>::iterator Scrollback::pageAt(size_t position)
+{
+    auto it = std::upper_bound(m_pages.begin(), m_pages.end(), position,
+                               [](size_t value, const Page &page) { return value < page.start; });
+    if (it == m_pages.begin())
+        return it;
+    --it;
+    return position < it->start + it->height ? it : it + 1;
+}
+
+size_t Scrollback::linesForSize(int size) const
+{
+    return (std::max(size - 1, 0) / std::max<size_t>(m_width, 1)) + 1;
+}
+
+void Scrollback::trim()
+{
+    // Never drop the newest block, however tall it is.
+    while (m_block_count > 1) {
+        Page &page = m_pages.front();
+        if (reflowPage(page))
+            updatePositions();
+        const size_t lines = page.blocks.empty()
+            ? linesForSize(page.sizes.at(page.dropped))
+            : page.blocks.front()->lineCount();
+        if (m_height - lines < m_max_size)
+            break;
+        dropOldestBlock();
+    }
+
+    // The page being filled is kept, whatever the budget. When spilling,
+    // that is all that can be done; spilled pages take next to no memory.
+    while (m_memory_limit && m_memory > m_memory_limit && m_pages.size() > 1) {
+        qCDebug(lcScrollback) << "Over the memory limit:" << m_memory << ">" << m_memory_limit;
+        if (m_spill_enabled) {
+            if (m_spilled_pages == m_pages.size() - 1)
+                break;
+            if (spill(m_pages[m_spilled_pages])) {
+                m_spilled_pages++;
+                continue;
+            }
+        }
+        dropOldestPage();
+    }
+}
+
+void Scrollback::dropOldestBlock()
+{
+    Page &page = m_pages.front();
+    size_t lines;
+    if (page.blocks.empty()) {
+        lines = linesForSize(page.sizes.at(page.dropped));
+    } else {
+        Block *block = page.blocks.front();
+        qCDebug(lcScrollback) << "Popping excess block " << block;
+        lines = block->lineCount();
+        if (!page.sealed) {
+            page.memory -= blockMemory(block);
+            m_memory -= blockMemory(block);
+        }
+        delete block;
+        page.blocks.pop_front();
+    }
+
+    // Sealed pages keep the sizes of dropped blocks to be able to walk
+    // their data.
+    if (page.sealed) {
+        page.dropped++;
+    } else {
+        page.sizes.removeFirst();
+        page.count--;
+    }
+
+    page.start += lines;
+    page.height -= lines;
+    m_block_count--;
+    m_height -= std::min(lines, m_height);
+    if (page.dropped == page.count)
+        popOldestPage();
+}
 
-    size_t current_line = m_height;
-    auto it = m_blocks.end();
+void Scrollback::dropOldestPage()
+{
+    Page &page = m_pages.front();
+    qCDebug(lcScrollback) << "Evicting page of" << page.count - page.dropped << "blocks";
+    for (Block *block : page.blocks)
+        delete block;
+    m_block_count -= page.count - page.dropped;
+    m_height -= std::min(page.height, m_height);
+    popOldestPage();
+}
+
+void Scrollback::popOldestPage()
+{
+    const Page &page = m_pages.front();
+    m_memory -= page.memory;
+    if (size_t(page.width) != m_width)
+        m_stale_pages--;
+    if (page.spill_offset >= 0)
+        releaseSpilled(m_pages.front());
+    m_pages.pop_front();
+}
+
+void Scrollback::releaseSpilled(Page &page)
+{
+    m_spill_live -= page.spill_size;
+    page.spill_offset = -1;
+    page.spill_size = 0;
+    m_spilled_pages--;
+    compactSpillFile();
+}
+
+// Spilled pages are only appended to the file, and dropped mostly from its
+// front. Once the dead space is more than what is still used, the pages in
+// use are moved down over it, so that with a line limit the file does not
+// grow for as long as the session lasts. As at most as much is copied as
+// was freed since the last time, this stays linear in what was spilled.
+void Scrollback::compactSpillFile()
+{
+    if (!m_spill_file || !m_spill_enabled)
+        return;
+    if (!m_spilled_pages) {
+        m_spill_file->resize(0);
+        return;
+    }
+    const qint64 dead = m_spill_file->size() - m_spill_live;
+    if (dead <= std::max(m_spill_live, spillCompactionMinimum))
+        return;
 
-    bool should_continue = true;
-    while (it != m_blocks.begin() && should_continue) {
-        --it;
-        const int block_height = (*it)->lineCount();
-        current_line -= block_height;
-        if (current_line > size_t(end.y())) {
+    // Pages only move towards the start of the file, and they are in file
+    // order, so none is overwritten before it has been moved. If anything
+    // fails, the pages moved so far are already where they say they are.
+    qint64 offset = 0;
+    QByteArray data;
+    for (Page &page : m_pages) {
+        if (page.spill_offset < 0)
             continue;
+        if (page.spill_offset != offset) {
+            if (!m_spill_file->seek(page.spill_offset)) {
+                qCWarning(lcScrollback) << "Could not compact spilled scrollback:" << m_spill_file->errorString();
+                return;
+            }
+            data = m_spill_file->read(page.spill_size);
+            if (data.size() != page.spill_size || !m_spill_file->seek(offset)
+                    || m_spill_file->write(data) != data.size()) {
+                qCWarning(lcScrollback) << "Could not compact spilled scrollback:" << m_spill_file->errorString();
+                return;
+            }
+            page.spill_offset = offset;
+        }
+        offset += page.spill_size;
+    }
+    m_spill_file->flush();
+    m_spill_file->resize(offset);
+    qCDebug(lcScrollback) << "Compacted the spill file from" << offset + dead << "to" << offset << "bytes";
+}
+
+// Moves the compressed data of a sealed page to the spill file. Returns
+// false if the file could not be written, in which case the page is left
+// as it was.
+bool Scrollback::spill(Page &page)
+{
+    Q_ASSERT(page.sealed && page.spill_offset < 0);
+    if (!m_spill_file) {
+        m_spill_file = new QTemporaryFile(QDir::tempPath() + QLatin1String("/yat-scrollback-XXXXXX"));
+        if (!m_spill_file->open()) {
+            qCWarning(lcScrollback) << "Could not create a scrollback spill file:" << m_spill_file->errorString();
+            delete m_spill_file;
+            m_spill_file = nullptr;
+            m_spill_enabled = false;
+            return false;
+        }
+    }
+
+    const qint64 offset = m_spill_file->size();
+    if (!m_spill_file->seek(offset) || m_spill_file->write(page.data) != page.data.size()
+            || !m_spill_file->flush()) {
+        qCWarning(lcScrollback) << "Could not spill scrollback:" << m_spill_file->errorString();
+        m_spill_file->resize(offset);
+        return false;
+    }
+
+    page.spill_offset = offset;
+    page.spill_size = page.data.size();
+    m_spill_live += page.spill_size;
+    page.data = QByteArray();
+    m_memory -= page.memory;
+    page.memory = sizeof(Page) + page.sizes.size() * sizeof(int)
+            + (page.styles.size() + page.clusters.size()) * sizeof(quint16);
+    m_memory += page.memory;
+    return true;
+}
+
+void Scrollback::seal(Page &page)
+{
+    Q_ASSERT(!page.sealed && page.dropped == 0);
+    QByteArray raw;
+    for (Block *block : page.blocks) {
+        appendBlock(&raw, block);
+        appendIds(&page.styles, &page.clusters, block);
+    }
+    sortUnique(&page.styles);
+    sortUnique(&page.clusters);
+    page.data = qCompress(raw, 1);
+    page.sealed = true;
+    m_memory -= page.memory;
+    page.memory = page.data.size() + page.sizes.size() * sizeof(int)
+            + (page.styles.size() + page.clusters.size()) * sizeof(quint16);
+    m_memory += page.memory;
+    qCDebug(lcScrollback) << "Sealed page of" << page.blocks.size() << "blocks:"
+                          << raw.size() << "->" << page.data.size() << "bytes";
+}
+
+void Scrollback::inflate(Page &page)
+{
+    if (!page.blocks.empty() || !page.sealed)
+        return;
+    Q_ASSERT(size_t(page.width) == m_width);
+
+    const QVector<int> &sizes = page.sizes;
+    QByteArray raw;
+    if (page.spill_offset >= 0) {
+        // Spilled pages are only mapped for as long as it takes to inflate.
+        if (uchar *mapped = m_spill_file->map(page.spill_offset, page.spill_size)) {
+            raw = qUncompress(mapped, page.spill_size);
+            m_spill_file->unmap(mapped);
+        } else {
+            qCWarning(lcScrollback) << "Could not map spilled scrollback:" << m_spill_file->errorString();
         }
+    } else {
+        raw = qUncompress(page.data);
+    }
 
-        int end_pos = (*it)->textSize();
-        if (current_line <= size_t(end.y()) && current_line + block_height >= size_t(end.y())) {
-            size_t end_line_count = end.y() - current_line;
-            end_pos = end_line_count * m_width + end.x();
+    const char *src = raw.constData();
+    QVector<TextCell> cells;
+    bool only_latin = true;
+    for (int i = 0; i < page.count; i++) {
+        if (i < page.dropped) {
+            if (!raw.isEmpty())
+                skipBlock(src, sizes.at(i));
+            continue;
         }
-        int start_pos = 0;
-        if (current_line <= size_t(start.y()) && current_line + block_height >= size_t(start.y())) {
-            size_t start_line_count = start.y() - current_line;
-            start_pos = start_line_count * m_width + start.x();
-            should_continue = false;
-        } else if (current_line + block_height < size_t(start.y())) {
-            should_continue = false;
+        if (raw.isEmpty()) {
+            // Keep the lines where they are even if the content is lost.
+            cells.fill(TextCell{ QChar(' '), m_screen->defaultStyleId() }, sizes.at(i));
+        } else {
+            readBlock(src, sizes.at(i), &cells, &only_latin);
         }
-        return_string.prepend((*it)->textLine().mid(start_pos, end_pos));
-        if (should_continue)
-            return_string.prepend(QChar('\n'));
+        Block *block = new Block(m_screen);
+        block->setCells(cells, only_latin);
+        block->setWidth(m_width);
+        page.blocks.push_back(block);
     }
+}
 
-    return return_string;
+// Works out the height of page for the current width. Returns whether it
+// changed, which moves all pages after it.
+bool Scrollback::reflowPage(Page &page)
+{
+    if (size_t(page.width) == m_width)
+        return false;
+
+    size_t height = 0;
+    if (page.blocks.empty()) {
+        const QVector<int> &sizes = page.sizes;
+        for (int i = page.dropped; i < page.count; i++)
+            height += linesForSize(sizes.at(i));
+    } else {
+        for (Block *b : page.blocks) {
+            b->setWidth(m_width);
+            height += b->lineCount();
+        }
+    }
+
+    const bool changed = height != page.height;
+    m_height = m_height - page.height + height;
+    page.height = height;
+    page.width = m_width;
+    m_stale_pages--;
+    return changed;
 }
 
-std::list<Block *>::iterator Scrollback::findIteratorForLine(size_t line)
+// Reflows the pages holding lines first to last. As their heights change,
+// other pages can move into the range, so this goes on until it is stable.
+void Scrollback::reflowLines(size_t first, size_t last)
 {
-   size_t current_line = m_height;
-    auto it = m_blocks.end();
-    while (it != m_blocks.begin()) {
-        --it;
-        current_line -= (*it)->lineCount();
-        if (current_line <= line)
-            return it;
+    bool moved = true;
+    while (moved && m_stale_pages) {
+        moved = false;
+        const size_t base = firstPosition();
+        for (auto page = pageForLine(first); page != m_pages.end() && page->start - base <= last; ++page)
+            moved |= reflowPage(*page);
+        if (moved)
+            updatePositions();
     }
-    return m_blocks.end();
 }
 
-const SelectionRange Scrollback::getDoubleClickSelectionRange(size_t character, size_t line)
+void Scrollback::updatePositions()
 {
-    auto it = findIteratorForLine(line);
-    if (it != m_blocks.end())
-        return Selection::getDoubleClickRange(it, character,line, m_width);
-    return { QPoint(), QPoint() };
+    size_t start = firstPosition();
+    for (Page &page : m_pages) {
+        page.start = start;
+        start += page.height;
+    }
+    // The visible pages may have moved anywhere.
+    m_visible_from = firstPosition();
+    m_visible_to = start;
+}
+
+void Scrollback::deflate(Page &page)
+{
+    if (!page.sealed)
+        return;
+
+    for (Block *block : page.blocks)
+        delete block;
+    page.blocks.clear();
 }
@@ -27,40 +27,143 @@
 
 #include "selection.h"
 
+#include <deque>
 #include <list>
 
 #include <QtCore/qglobal.h>
+#include <QtCore/QBitArray>
+#include <QtCore/QByteArray>
 #include <QtCore/QPoint>
+#include <QtCore/QVector>
 
 class Block;
+class Screen;
+class QTemporaryFile;
+class QIODevice;
 
 class Scrollback
 {
 public:
-    Scrollback(size_t max_size);
+    Scrollback(size_t max_size, Screen *screen);
+    ~Scrollback();
 
-    void addBlock(Block *block);
+    void addBlocks(std::list<Block *> *blocks);
     Block *reclaimBlock();
     void ensureVisibleLines(int screenHeight, int top_line);
     void fixupVisibility(int screenHeight);
 
     size_t height() const;
+    // The most lines kept; SIZE_MAX keeps everything the memory limit allows.
+    size_t maxSize() const { return m_max_size; }
+    void setMaxSize(size_t max_size);
+    // Over this many bytes, the oldest pages are evicted. 0 is no limit.
+    size_t memoryLimit() const { return m_memory_limit; }
+    void setMemoryLimit(size_t bytes);
+    // Bytes taken by the stored lines, not counting pages that are only
+    // inflated while on screen.
+    size_t memoryUsage() const { return m_memory; }
+    // With spilling enabled, pages over the memory limit are written to a
+    // temporary file and mapped back in when needed, instead of evicted.
+    bool spillEnabled() const { return m_spill_enabled; }
+    void setSpillEnabled(bool enabled);
+    size_t spilledPages() const { return m_spilled_pages; }
+    qint64 spillFileSize() const;
 
+    // Changing the width only reflows the pages in the viewport; the others
+    // get an estimated height until reflow() gets to them.
     void setWidth(int screenHeight, int width);
+    bool reflowPending() const { return m_stale_pages; }
+    bool reflow(int screenHeight, int msecs);
 
     size_t blockCount() { return m_block_count; }
+    void markLiveStyles(QBitArray *live) const;
+    void markLiveClusters(QBitArray *live) const;
 
-    QString selection(const QPoint &start, const QPoint &end) const;
+    // Selections are copied in order, measured first so the string is
+    // allocated once. Lines are joined with '\n'.
+    QString selection(const QPoint &start, const QPoint &end);
+    size_t selectionSize(const QPoint &start, const QPoint &end);
+    void appendSelection(QString *out, const QPoint &start, const QPoint &end);
+    // Writes the selection as UTF-8 a piece at a time, for selections too
+    // big to copy into a string.
+    bool writeSelection(const QPoint &start, const QPoint &end, QIODevice *device);
     const SelectionRange getDoubleClickSelectionRange(size_t character, size_t line);
 private:
-    std::list<Block *>::iterator findIteratorForLine(size_t line);
+    // A run of retired blocks. Once a page is full it is sealed: its cells
+    // are compressed into data, and the blocks only exist while the page is
+    // on screen or being read from.
+    struct Page
+    {
+        std::list<Block *> blocks;
+        QByteArray data;
+        // Where data went in the spill file, if it was spilled.
+        qint64 spill_offset = -1;
+        int spill_size = 0;
+        // Cell count of every block in data, so line counts can be worked
+        // out without inflating the page. Spilled pages keep them in memory
+        // too, as trimming and reflowing go through them a block at a time.
+        QVector<int> sizes;
+        // Style ids used in data, so the style table can tell which ids are
+        // live without inflating the page.
+        QVector<quint16> styles;
+        // The same for the clusters in data.
+        QVector<ushort> clusters;
+        // Blocks in the page, dropped ones included.
+        int count = 0;
+        // Position of the first line. Positions count from the start of the
+        // scrollback as of the last resize, so they do not change when
+        // older lines are dropped, and line n is at firstPosition() + n.
+        size_t start = 0;
+        // The width height was worked out for, or 0 if it is an estimate.
+        int width = 0;
+        // Blocks at the front of data that were trimmed off the scrollback.
+        int dropped = 0;
+        size_t height = 0;
+        size_t memory = 0;
+        bool sealed = false;
+        bool visible = false;
+    };
 
-    std::list<Block *> m_blocks;
+    size_t linesForSize(int size) const;
+    size_t firstPosition() const { return m_pages.empty() ? 0 : m_pages.front().start; }
+    std::deque<Page>::iterator pageAt(size_t position);
+    std::deque<Page>::iterator pageForLine(size_t line) { return pageAt(firstPosition() + line); }
+    bool reflowPage(Page &page);
+    void reflowLines(size_t first, size_t last);
+    void updatePositions();
+    bool prepareSelection(const QPoint &start, QPoint *end);
+    template <typename Segment>
+    void walkSelection(const QPoint &start, const QPoint &end, bool with_text, Segment segment);
+    void trim();
+    void dropOldestBlock();
+    void dropOldestPage();
+    void popOldestPage();
+    bool spill(Page &page);
+    void releaseSpilled(Page &page);
+    void compactSpillFile();
+    void seal(Page &page);
+    void inflate(Page &page);
+    void deflate(Page &page);
+
+    std::deque<Page> m_pages;
+    Screen *m_screen;
     size_t m_height;
     size_t m_width;
+    size_t m_stale_pages;
     size_t m_block_count;
     size_t m_max_size;
+    size_t m_memory_limit;
+    size_t m_memory;
+    // Spilled pages are always the oldest ones.
+    QTemporaryFile *m_spill_file;
+    size_t m_spilled_pages;
+    // Bytes of the spill file that spilled pages still use.
+    qint64 m_spill_live;
+    bool m_spill_enabled;
     int m_firstVisibleLine;
+    // Positions of the pages marked visible, which are always a run.
+    size_t m_visible_from;
+    size_t m_visible_to;
 };
 
 #endif //SCROLLBACK_H
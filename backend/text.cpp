@@ -37,7 +37,7 @@ Text::Text(Screen *screen)
     , m_old_line(0)
     , m_width(1)
     , m_style(screen->defaultTextStyle())
-    , m_new_style(screen->defaultTextStyle())
+    , m_new_style(m_style)
     , m_style_dirty(true)
     , m_text_dirty(true)
     , m_visible(true)
@@ -107,9 +107,10 @@ void Text::setStringSegment(int start_index, int end_index, bool text_changed)
     m_text_dirty = text_changed;
 }
 
-void Text::setTextStyle(const TextStyle &style)
+void Text::setTextStyle(quint16 style_id)
 {
-    m_new_style = style;
+    // Looked up now, as the id may be reclaimed before the next dispatch.
+    m_new_style = m_screen->styleTable().style(style_id);
     m_style_dirty = true;
 }
 
@@ -161,7 +162,12 @@ void Text::dispatchEvents()
             || m_text_dirty) {
         m_text_dirty = false;
         QString old_text = m_text;
-        m_text = m_text_line->mid(m_start_index, m_end_index - m_start_index + 1);
+        if (m_latin) {
+            m_text = m_text_line->mid(m_start_index, m_end_index - m_start_index + 1);
+        } else {
+            m_text.resize(0);
+            m_screen->clusterTable().appendText(&m_text, m_text_line->constData() + m_start_index, m_end_index - m_start_index + 1);
+        }
         if (m_old_start_index != m_start_index) {
             m_old_start_index = m_start_index;
             emit indexChanged();
@@ -169,12 +175,16 @@ void Text::dispatchEvents()
         emit textChanged();
     }
 
+    if (m_style_dirty && m_new_style == m_style)
+        m_style_dirty = false;
+
     if (m_style_dirty) {
         m_style_dirty = false;
 
-        bool emit_foreground = m_new_style.foreground != m_style.foreground;
-        bool emit_background = m_new_style.background != m_style.background;
-        TextStyle::Styles new_style = m_new_style.style;
+        const TextStyle &next_style = m_new_style;
+        bool emit_foreground = next_style.foreground != m_style.foreground;
+        bool emit_background = next_style.background != m_style.background;
+        TextStyle::Styles new_style = next_style.style;
         TextStyle::Styles old_style = m_style.style;
 
         bool emit_bold = false;
@@ -188,7 +198,7 @@ void Text::dispatchEvents()
             emit_inverse = differentStyle(new_style, old_style, TextStyle::Inverse);
         }
 
-        m_style = m_new_style;
+        m_style = next_style;
         if (emit_inverse) {
             setForegroundColor();
             setBackgroundColor();
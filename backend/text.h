@@ -61,7 +61,7 @@ public:
     QColor backgroundColor() const;
 
     void setStringSegment(int start_index, int end_index, bool textChanged);
-    void setTextStyle(const TextStyle &style);
+    void setTextStyle(quint16 style_id);
 
     bool bold() const;
     bool blinking() const;
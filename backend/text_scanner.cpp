@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "text_scanner.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__)
+#define YAT_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+namespace TextScanner {
+
+static int findNonPrintableScalar(const char *data, int from, int size)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    for (int i = from; i < size; i++) {
+        if (bytes[i] < 0x20 || bytes[i] >= 0x7f)
+            return i;
+    }
+    return size;
+}
+
+#ifdef YAT_SCANNER_X86
+// Bytes are compared as signed, so everything from 0x80 up is negative and
+// fails the "greater than 0x1f" test along with the C0 controls.
+static int findNonPrintableSSE2(const char *data, int from, int size)
+{
+    const __m128i lower = _mm_set1_epi8(0x1f);
+    const __m128i upper = _mm_set1_epi8(0x7f);
+    int i = from;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(chunk, lower),
+                                                _mm_cmplt_epi8(chunk, upper));
+        const unsigned mask = ~unsigned(_mm_movemask_epi8(printable)) & 0xffff;
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return findNonPrintableScalar(data, i, size);
+}
+
+__attribute__((target("avx2")))
+static int findNonPrintableAVX2(const char *data, int from, int size)
+{
+    const __m256i lower = _mm256_set1_epi8(0x1f);
+    const __m256i upper = _mm256_set1_epi8(0x7f);
+    int i = from;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, lower),
+                                                   _mm256_cmpgt_epi8(upper, chunk));
+        const unsigned mask = ~unsigned(_mm256_movemask_epi8(printable));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return findNonPrintableSSE2(data, i, size);
+}
+#endif
+
+typedef int (*ScanFunction)(const char *data, int from, int size);
+
+static Implementation bestImplementation()
+{
+#ifdef YAT_SCANNER_X86
+    if (__builtin_cpu_supports("avx2"))
+        return AVX2;
+    return SSE2;
+#else
+    return Scalar;
+#endif
+}
+
+static ScanFunction functionFor(Implementation implementation)
+{
+    switch (implementation) {
+#ifdef YAT_SCANNER_X86
+    case AVX2:
+        return findNonPrintableAVX2;
+    case SSE2:
+        return findNonPrintableSSE2;
+#endif
+    default:
+        return findNonPrintableScalar;
+    }
+}
+
+static Implementation s_implementation = bestImplementation();
+static ScanFunction s_scan = functionFor(s_implementation);
+
+int findNonPrintable(const char *data, int from, int size)
+{
+    return s_scan(data, from, size);
+}
+
+Implementation implementation()
+{
+    return s_implementation;
+}
+
+bool isSupported(Implementation implementation)
+{
+    return implementation <= bestImplementation();
+}
+
+bool setImplementation(Implementation implementation)
+{
+    if (!isSupported(implementation))
+        return false;
+    s_implementation = implementation;
+    s_scan = functionFor(implementation);
+    return true;
+}
+
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef TEXT_SCANNER_H
+#define TEXT_SCANNER_H
+
+// Finds the end of a run of printable ASCII (0x20-0x7e) so the parser can
+// skip over plain text without looking at every byte. The vector version to
+// use is picked at runtime, based on what the CPU supports.
+namespace TextScanner {
+
+enum Implementation {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Returns the index of the first byte in data[from, size) that is below
+// 0x20, 0x7f, or 0x80 and above, or size if there is none.
+int findNonPrintable(const char *data, int from, int size);
+
+Implementation implementation();
+bool isSupported(Implementation implementation);
+// Forces a particular implementation, for tests and benchmarks. Returns false
+// (and changes nothing) if the CPU does not support it.
+bool setImplementation(Implementation implementation);
+
+}
+
+#endif // TEXT_SCANNER_H
@@ -4,6 +4,9 @@
 #include "text.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QLoggingCategory>
+
+Q_LOGGING_CATEGORY(lcTextStyle, "yat.textstyle", QtWarningMsg)
 
 TextStyle::TextStyle()
     : style(Normal)
@@ -19,6 +22,76 @@ bool TextStyle::isCompatible(const TextStyle &other) const
             && style == other.style;
 }
 
+uint qHash(const TextStyle &style, uint seed)
+{
+    return qHash(quint64(style.foreground) << 32 | style.background, seed) ^ uint(style.style);
+}
+
+// Looking for live ids walks the screen and scrollback, so while nearly all
+// of them are in use, it is only done once per this many new styles.
+static const int reclaimInterval = 1024;
+
+TextStyleTable::TextStyleTable(Screen *screen)
+    : m_screen(screen)
+    , m_last_id(-1)
+    , m_reclaim_delay(0)
+    , m_warned_full(false)
+{
+}
+
+quint16 TextStyleTable::intern(const TextStyle &style)
+{
+    // Runs of text mostly come in the same style as the one before.
+    if (m_last_id >= 0 && m_styles.at(m_last_id) == style)
+        return quint16(m_last_id);
+
+    auto it = m_ids.constFind(style);
+    if (it != m_ids.constEnd()) {
+        m_last_id = it.value();
+        return quint16(m_last_id);
+    }
+
+    if (m_styles.size() > 0xffff && m_free.isEmpty()) {
+        if (--m_reclaim_delay <= 0)
+            reclaim();
+        if (m_free.isEmpty()) {
+            if (!m_warned_full) {
+                qCWarning(lcTextStyle) << "Out of text style ids, using the default style for new styles";
+                m_warned_full = true;
+            }
+            return 0;
+        }
+    }
+
+    if (m_free.isEmpty()) {
+        m_last_id = m_styles.size();
+        m_styles.append(style);
+    } else {
+        m_last_id = m_free.takeLast();
+        m_styles[m_last_id] = style;
+    }
+    m_ids.insert(style, quint16(m_last_id));
+    return quint16(m_last_id);
+}
+
+void TextStyleTable::reclaim()
+{
+    QBitArray live(m_styles.size());
+    m_screen->markLiveStyles(&live);
+
+    for (int id = m_styles.size() - 1; id >= 0; id--) {
+        if (live.testBit(id))
+            continue;
+        m_ids.remove(m_styles.at(id));
+        m_free.append(quint16(id));
+    }
+    if (m_last_id >= 0 && !live.testBit(m_last_id))
+        m_last_id = -1;
+
+    m_reclaim_delay = m_free.size() < reclaimInterval ? reclaimInterval : 0;
+    qCDebug(lcTextStyle) << "Reclaimed" << m_free.size() << "text style ids";
+}
+
 QDebug operator<<(QDebug debug, TextStyleLine line)
 {
     debug << "[" << line.start_index << "(" << line.style << ":" << line.foreground << ":" << line.background << ")" << line.end_index << "]";
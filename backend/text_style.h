@@ -2,6 +2,9 @@
 #define TEXT_STYLE_H
 
 #include <QtGui/QColor>
+#include <QtCore/QBitArray>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
 
 #include "color_palette.h"
 
@@ -35,11 +38,44 @@ public:
     bool isCompatible(const TextStyle &other) const;
 };
 
+inline bool operator==(const TextStyle &a, const TextStyle &b) { return a.isCompatible(b); }
+uint qHash(const TextStyle &style, uint seed = 0);
+
+// Hands out a small integer id for every distinct TextStyle seen on a Screen,
+// so cells and text segments can store and compare styles as one quint16.
+// Once all of them are taken, the Screen is asked which ids are still used
+// by its cells, scrollback and cursors, and the rest are handed out again.
+// If that frees nothing, new styles fall back to id 0.
+class TextStyleTable
+{
+public:
+    TextStyleTable(Screen *screen);
+
+    quint16 intern(const TextStyle &style);
+    const TextStyle &style(quint16 id) const { return m_styles.at(id); }
+    // Ids in use, which is not the same as the highest id once some have
+    // been reclaimed.
+    int size() const { return m_styles.size() - m_free.size(); }
+
+private:
+    void reclaim();
+
+    Screen *m_screen;
+    QVector<TextStyle> m_styles;
+    QHash<TextStyle, quint16> m_ids;
+    QVector<quint16> m_free;
+    // -1 when the last id handed out has been reclaimed since.
+    int m_last_id;
+    int m_reclaim_delay;
+    bool m_warned_full;
+};
+
 class Text;
 class TextStyleLine : public TextStyle {
 public:
-    TextStyleLine(const TextStyle &style, int start_index, int end_index)
+    TextStyleLine(const TextStyle &style, int start_index, int end_index, quint16 style_id = 0)
         : TextStyle(style)
+        , style_id(style_id)
         , start_index(start_index)
         , end_index(end_index)
         , old_index(-1)
@@ -51,7 +87,8 @@ public:
     }
 
     TextStyleLine()
-        : start_index(0)
+        : style_id(0)
+        , start_index(0)
         , end_index(0)
         , old_index(-1)
         , text_segment(0)
@@ -64,6 +101,7 @@ public:
 
     void releaseTextSegment(Screen *screen);
 
+    quint16 style_id;
     int start_index;
     int end_index;
 
@@ -24,86 +24,92 @@
 #ifndef UTF8_DECODER
 #define UTF8_DECODER
 
-#include "controll_chars.h"
+#include <QtCore/qglobal.h>
 
+#include <stddef.h>
+
+// A table driven UTF-8 decoder, after Bjoern Hoehrmann's DFA. Every byte
+// is mapped to a class, and the class and current state give the next
+// state. Overlong forms, surrogates, code points past U+10FFFF and the old
+// five and six byte forms are all rejected. Invalid sequences become one
+// U+FFFD each, and the byte that broke off a sequence is decoded again on
+// its own. A sequence that is split over two calls is picked up in the
+// next one.
 class Utf8Decoder
 {
 public:
-    inline Utf8Decoder();
+    enum {
+        Accept = 0,
+        Reject = 12
+    };
+    static const char32_t ReplacementCharacter = 0xfffd;
 
-    inline void addChar(uchar character);
+    Utf8Decoder() { clear(); }
 
-    inline bool isLatin() const;
-    inline bool isC1() const;
+    // Decodes size bytes to code points, returning how many were written.
+    // out needs room for size + 1 of them.
+    size_t decode(const char *data, size_t size, char32_t *out);
 
-    inline void clear();
-private:
-    short m_expected_length;
-    short m_length;
-    uint32_t m_unicode;
-};
+    // Feeds a single byte, calling emit with every code point it completes:
+    // none, one, or a replacement character followed by one.
+    template <typename Emit>
+    inline void feed(uchar byte, Emit emit);
+    bool isPending() const { return m_state != Accept; }
 
-Utf8Decoder::Utf8Decoder()
-{
-    clear();
-}
+    // For the parser, which only needs to know whether a run of text can
+    // take the Latin-1 path.
+    inline void addChar(uchar character);
+    bool isLatin() const { return m_latin; }
 
-void Utf8Decoder::addChar(uchar character)
-{
-    if (m_length && m_length == m_expected_length) {
-        clear();
+    void clear()
+    {
+        m_state = Accept;
+        m_code_point = 0;
+        m_latin = true;
     }
 
-    if (character < 0x80)
-        return;
+private:
+    static const uchar s_table[];
+
+    uint m_state;
+    char32_t m_code_point;
+    bool m_latin;
+};
 
-    //fprintf(stderr, "Character: 0x%x\n", character);
-    if (m_expected_length == 0) {
-        //this is naive. There must be a faster way.
-        if ((character & 0xfc) == 0xfc) {
-            m_expected_length = 5;
-            m_unicode = character & 0x01;
-        } else if ((character & 0xf8) == 0xf8) {
-            m_expected_length = 4;
-            m_unicode = character & 0x03;
-        } else if ((character & 0xf0) == 0xf0) {
-            m_expected_length = 3;
-            m_unicode = character & 0x07;
-        } else if ((character & 0xe0) == 0xe0) {
-            m_expected_length = 2;
-            m_unicode = character & 0x0f;
-        } else if ((character & 0xc0) == 0xc0) {
-            m_expected_length = 1;
-            m_unicode = character & 0x1f;
-        } else {
-            m_expected_length = 0;
-            m_unicode = 0;
-            qWarning("Utf8Decoder: invalid decoder character");
+template <typename Emit>
+void Utf8Decoder::feed(uchar byte, Emit emit)
+{
+    const uint type = s_table[byte];
+    if (m_state != Accept) {
+        const uint state = s_table[256 + m_state + type];
+        if (state != Reject) {
+            m_code_point = (m_code_point << 6) | (byte & 0x3f);
+            m_state = state;
+            if (state == Accept)
+                emit(m_code_point);
+            return;
         }
-    } else {
-        //fprintf(stderr, "Before 0x%x adding 0x%x pure 0x%x\n", m_unicode,(character & 0x3f), character);
-        m_unicode = (m_unicode << 6) |  (character & 0x3f);
-        //fprintf(stderr, "After 0x%x\n", m_unicode);
-        m_length++;
+        emit(ReplacementCharacter);
     }
-}
-
-bool Utf8Decoder::isLatin() const
-{
-    return m_expected_length < 2 && m_unicode < 0xff;
-}
 
-bool Utf8Decoder::isC1() const
-{
-    return m_expected_length == 2 && m_length == m_expected_length &&
-        (m_unicode >= C1_8bit::C1_8bit_Start && m_unicode <= C1_8bit::C1_8bit_Stop);
+    m_code_point = (0xff >> type) & byte;
+    m_state = s_table[256 + type];
+    if (m_state == Accept) {
+        emit(m_code_point);
+    } else if (m_state == Reject) {
+        m_state = Accept;
+        emit(ReplacementCharacter);
+    }
 }
 
-void Utf8Decoder::clear()
+void Utf8Decoder::addChar(uchar character)
 {
-    m_expected_length = 0;
-    m_length = 0;
-    m_unicode = 0;
+    // Only what the byte completes counts, a sequence still in progress is
+    // judged by its last byte.
+    m_latin = true;
+    feed(character, [this](char32_t code_point) {
+        m_latin = m_latin && code_point < 0xff;
+    });
 }
 
 #endif
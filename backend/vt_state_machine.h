@@ -0,0 +1,346 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef VT_STATE_MACHINE_H
+#define VT_STATE_MACHINE_H
+
+#include <stdint.h>
+
+// The DEC VT500 series parser as described by Paul Williams:
+// http://vt100.net/emu/dec_ansi_parser
+//
+// Both tables are generated at compile time. Every input byte is first mapped
+// to a byte class, and the (state, class) pair then gives the action to run
+// and the next state, so the parser loop is two array lookups per byte.
+//
+// Deviations from the original diagram, to suit a UTF-8 terminal:
+//  - 0x80-0xff are never C1 controls. They are printed in Ground, forwarded in
+//    OSC strings (so titles may contain UTF-8) and ignored elsewhere.
+//  - ':' is a parameter byte (for sub-parameters such as 38:2:r:g:b) rather
+//    than sending the CSI to CsiIgnore.
+//  - Private markers ('<', '=', '>', '?') at the start of a CSI are handed to
+//    the Param action, which is where Parser tracks DEC and '>' modes.
+//  - BEL terminates an OSC string, as xterm does.
+namespace VtStateMachine {
+
+enum State {
+    Ground,
+    Escape,
+    EscapeIntermediate,
+    CsiEntry,
+    CsiParam,
+    CsiIntermediate,
+    CsiIgnore,
+    DcsEntry,
+    DcsParam,
+    DcsIntermediate,
+    DcsPassthrough,
+    DcsIgnore,
+    OscString,
+    SosPmApcString,
+    StateCount
+};
+
+enum Action {
+    None,
+    Ignore,
+    Print,
+    Execute,
+    Clear,
+    Collect,
+    Param,
+    EscDispatch,
+    CsiDispatch,
+    Hook,
+    Put,
+    Unhook,
+    OscStart,
+    OscPut,
+    OscEnd,
+    ActionCount
+};
+
+enum ByteClass {
+    ClassC0,            // 0x00-0x06, 0x08-0x17, 0x19, 0x1c-0x1f
+    ClassBel,           // 0x07
+    ClassCancel,        // 0x18 CAN, 0x1a SUB
+    ClassEsc,           // 0x1b
+    ClassIntermediate,  // 0x20-0x2f
+    ClassDigit,         // 0x30-0x39
+    ClassColon,         // 0x3a
+    ClassSemicolon,     // 0x3b
+    ClassPrivate,       // 0x3c-0x3f
+    ClassUpper,         // 0x40-0x4f, 0x51-0x57, 0x59, 0x5a, 0x5c
+    ClassDcs,           // 0x50 'P'
+    ClassSosPmApc,      // 0x58 'X', 0x5e '^', 0x5f '_'
+    ClassCsi,           // 0x5b '['
+    ClassOsc,           // 0x5d ']'
+    ClassLower,         // 0x60-0x7e
+    ClassDel,           // 0x7f
+    ClassHigh,          // 0x80-0xff
+    ClassCount
+};
+
+// A transition is packed into 16 bits: the next state in the low nibble, a
+// flag telling whether exit/entry actions run, and the transition action in
+// the high byte.
+typedef uint16_t Transition;
+
+enum {
+    StateMask = 0x0f,
+    StateChangeFlag = 0x10,
+    ActionShift = 8
+};
+
+constexpr Transition makeTransition(Action action, State state, bool changesState)
+{
+    return Transition((action << ActionShift) | (changesState ? StateChangeFlag : 0) | state);
+}
+
+inline State transitionState(Transition t) { return State(t & StateMask); }
+inline Action transitionAction(Transition t) { return Action(t >> ActionShift); }
+inline bool transitionChangesState(Transition t) { return t & StateChangeFlag; }
+
+struct ByteClassTable
+{
+    uint8_t classes[256];
+};
+
+struct TransitionTable
+{
+    Transition transitions[StateCount][ClassCount];
+    uint8_t entryActions[StateCount];
+    uint8_t exitActions[StateCount];
+};
+
+constexpr ByteClass classify(int byte)
+{
+    return byte == 0x07 ? ClassBel
+         : byte == 0x18 || byte == 0x1a ? ClassCancel
+         : byte == 0x1b ? ClassEsc
+         : byte < 0x20 ? ClassC0
+         : byte < 0x30 ? ClassIntermediate
+         : byte < 0x3a ? ClassDigit
+         : byte == 0x3a ? ClassColon
+         : byte == 0x3b ? ClassSemicolon
+         : byte < 0x40 ? ClassPrivate
+         : byte == 0x50 ? ClassDcs
+         : byte == 0x58 || byte == 0x5e || byte == 0x5f ? ClassSosPmApc
+         : byte == 0x5b ? ClassCsi
+         : byte == 0x5d ? ClassOsc
+         : byte < 0x60 ? ClassUpper
+         : byte < 0x7f ? ClassLower
+         : byte == 0x7f ? ClassDel
+         : ClassHigh;
+}
+
+constexpr ByteClassTable makeByteClassTable()
+{
+    ByteClassTable table = {};
+    for (int i = 0; i < 256; i++)
+        table.classes[i] = classify(i);
+    return table;
+}
+
+constexpr bool isFinal(int byteClass)
+{
+    return byteClass >= ClassUpper && byteClass <= ClassLower;
+}
+
+constexpr bool isParameter(int byteClass)
+{
+    return byteClass == ClassDigit || byteClass == ClassColon || byteClass == ClassSemicolon;
+}
+
+// Bytes 0x30-0x7e, the range that finishes an escape sequence.
+constexpr bool isEscapeFinal(int byteClass)
+{
+    return isParameter(byteClass) || byteClass == ClassPrivate || isFinal(byteClass);
+}
+
+constexpr TransitionTable makeTransitionTable()
+{
+    TransitionTable table = {};
+
+    for (int s = 0; s < StateCount; s++) {
+        const State state = State(s);
+        for (int c = 0; c < ClassCount; c++) {
+            // Default: stay where we are and drop the byte.
+            Transition t = makeTransition(Ignore, state, false);
+
+            switch (state) {
+            case Ground:
+                if (c == ClassC0 || c == ClassBel)
+                    t = makeTransition(Execute, Ground, false);
+                else if (c != ClassDel)
+                    t = makeTransition(Print, Ground, false);
+                break;
+            case Escape:
+                if (c == ClassC0 || c == ClassBel)
+                    t = makeTransition(Execute, Escape, false);
+                else if (c == ClassIntermediate)
+                    t = makeTransition(Collect, EscapeIntermediate, true);
+                else if (c == ClassDcs)
+                    t = makeTransition(None, DcsEntry, true);
+                else if (c == ClassSosPmApc)
+                    t = makeTransition(None, SosPmApcString, true);
+                else if (c == ClassCsi)
+                    t = makeTransition(None, CsiEntry, true);
+                else if (c == ClassOsc)
+                    t = makeTransition(None, OscString, true);
+                else if (isEscapeFinal(c))
+                    t = makeTransition(EscDispatch, Ground, true);
+                break;
+            case EscapeIntermediate:
+                if (c == ClassC0 || c == ClassBel)
+                    t = makeTransition(Execute, EscapeIntermediate, false);
+                else if (c == ClassIntermediate)
+                    t = makeTransition(Collect, EscapeIntermediate, false);
+                else if (isEscapeFinal(c))
+                    t = makeTransition(EscDispatch, Ground, true);
+                break;
+            case CsiEntry:
+                if (c == ClassC0 || c == ClassBel)
+                    t = makeTransition(Execute, CsiEntry, false);
+                else if (c == ClassIntermediate)
+                    t = makeTransition(Collect, CsiIntermediate, true);
+                else if (isParameter(c) || c == ClassPrivate)
+                    t = makeTransition(Param, CsiParam, true);
+                else if (isFinal(c))
+                    t = makeTransition(CsiDispatch, Ground, true);
+                break;
+            case CsiParam:
+                if (c == ClassC0 || c == ClassBel)
+                    t = makeTransition(Execute, CsiParam, false);
+                else if (isParameter(c))
+                    t = makeTransition(Param, CsiParam, false);
+                else if (c == ClassPrivate)
+                    t = makeTransition(None, CsiIgnore, true);
+                else if (c == ClassIntermediate)
+                    t = makeTransition(Collect, CsiIntermediate, true);
+                else if (isFinal(c))
+                    t = makeTransition(CsiDispatch, Ground, true);
+                break;
+            case CsiIntermediate:
+                if (c == ClassC0 || c == ClassBel)
+                    t = makeTransition(Execute, CsiIntermediate, false);
+                else if (c == ClassIntermediate)
+                    t = makeTransition(Collect, CsiIntermediate, false);
+                else if (isParameter(c) || c == ClassPrivate)
+                    t = makeTransition(None, CsiIgnore, true);
+                else if (isFinal(c))
+                    t = makeTransition(CsiDispatch, Ground, true);
+                break;
+            case CsiIgnore:
+                if (c == ClassC0 || c == ClassBel)
+                    t = makeTransition(Execute, CsiIgnore, false);
+                else if (isFinal(c))
+                    t = makeTransition(None, Ground, true);
+                break;
+            case DcsEntry:
+                if (c == ClassIntermediate)
+                    t = makeTransition(Collect, DcsIntermediate, true);
+                else if (isParameter(c) || c == ClassPrivate)
+                    t = makeTransition(Param, DcsParam, true);
+                else if (isFinal(c))
+                    t = makeTransition(None, DcsPassthrough, true);
+                break;
+            case DcsParam:
+                if (isParameter(c))
+                    t = makeTransition(Param, DcsParam, false);
+                else if (c == ClassPrivate)
+                    t = makeTransition(None, DcsIgnore, true);
+                else if (c == ClassIntermediate)
+                    t = makeTransition(Collect, DcsIntermediate, true);
+                else if (isFinal(c))
+                    t = makeTransition(None, DcsPassthrough, true);
+                break;
+            case DcsIntermediate:
+                if (c == ClassIntermediate)
+                    t = makeTransition(Collect, DcsIntermediate, false);
+                else if (isParameter(c) || c == ClassPrivate)
+                    t = makeTransition(None, DcsIgnore, true);
+                else if (isFinal(c))
+                    t = makeTransition(None, DcsPassthrough, true);
+                break;
+            case DcsPassthrough:
+                if (c != ClassDel)
+                    t = makeTransition(Put, DcsPassthrough, false);
+                break;
+            case DcsIgnore:
+                break;
+            case OscString:
+                if (c == ClassBel)
+                    t = makeTransition(None, Ground, true);
+                else if (c != ClassC0)
+                    t = makeTransition(OscPut, OscString, false);
+                break;
+            case SosPmApcString:
+            case StateCount:
+                break;
+            }
+
+            // The "anywhere" transitions take priority over everything above.
+            if (c == ClassCancel)
+                t = makeTransition(Execute, Ground, true);
+            else if (c == ClassEsc)
+                t = makeTransition(None, Escape, true);
+
+            table.transitions[s][c] = t;
+        }
+        table.entryActions[s] = None;
+        table.exitActions[s] = None;
+    }
+
+    table.entryActions[Escape] = Clear;
+    table.entryActions[CsiEntry] = Clear;
+    table.entryActions[DcsEntry] = Clear;
+    table.entryActions[OscString] = OscStart;
+    table.entryActions[DcsPassthrough] = Hook;
+    table.exitActions[OscString] = OscEnd;
+    table.exitActions[DcsPassthrough] = Unhook;
+
+    return table;
+}
+
+static constexpr ByteClassTable byteClassTable = makeByteClassTable();
+static constexpr TransitionTable transitionTable = makeTransitionTable();
+
+inline Transition transition(State state, unsigned char byte)
+{
+    return transitionTable.transitions[state][byteClassTable.classes[byte]];
+}
+
+inline Action entryAction(State state)
+{
+    return Action(transitionTable.entryActions[state]);
+}
+
+inline Action exitAction(State state)
+{
+    return Action(transitionTable.exitActions[state]);
+}
+
+}
+
+#endif // VT_STATE_MACHINE_H
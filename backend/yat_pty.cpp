@@ -45,6 +45,8 @@
 #include <QtCore/QSocketNotifier>
 #include <QtCore/QDebug>
 
+#include <algorithm>
+
 static char env_variables[][255] = {
     "TERM=xterm-256color",
     "COLORTERM=xterm",
@@ -55,8 +57,17 @@ static char env_variables[][255] = {
 };
 static int env_variables_size = sizeof(env_variables) / sizeof(env_variables[0]);
 
+// The read buffer starts small, so interactive use stays cheap, and grows to
+// fit what a wakeup drains.
+static const int minReadSize = 4096;
+static const int maxReadSize = 1 << 20;
+
 YatPty::YatPty()
     : m_winsize(0)
+    , m_reader(0)
+    , m_reader_thread(0)
+    , m_read_size(minReadSize)
+    , m_read_enabled(true)
 {
     m_terminal_pid = forkpty(&m_master_fd,
                              NULL,
@@ -88,12 +99,20 @@ YatPty::YatPty()
         exit(0);
     }
 
-    m_reader = new QSocketNotifier(m_master_fd,QSocketNotifier::Read,this);
-    connect(m_reader, &QSocketNotifier::activated, this, &YatPty::readData);
+    if (qgetenv("YAT_PTY_READER") == "thread") {
+        m_reader_thread = new PtyReader(m_master_fd, this);
+        connect(m_reader_thread, &PtyReader::dataAvailable, this, &YatPty::readFromReader);
+        m_reader_thread->start();
+    } else {
+        m_reader = new QSocketNotifier(m_master_fd,QSocketNotifier::Read,this);
+        connect(m_reader, &QSocketNotifier::activated, this, &YatPty::readData);
+    }
 }
 
 YatPty::~YatPty()
 {
+    if (m_reader_thread)
+        m_reader_thread->stop();
 }
 
 void YatPty::write(const QByteArray &data)
@@ -136,15 +155,206 @@ int YatPty::masterDevice() const
 }
 
 
+static bool hasPendingData(int fd)
+{
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    return ::poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+}
+
+// Keeps reading for as long as poll() says more is pending, or until
+// maxReadSize has been read, so the parser gets one large chunk per wakeup
+// instead of one per read. The master device is blocking, so a read is only
+// made when data is known to be there, and anything but EINTR that does not
+// return data is a hangup. The line discipline hands over a few KB per read
+// however much is pending, so the buffer is sized from what the whole wakeup
+// drained.
 void YatPty::readData()
 {
-    int size_of_buffer = sizeof m_data_buffer / sizeof *m_data_buffer;
-    ssize_t read_size = ::read(m_master_fd,m_data_buffer,size_of_buffer);
-    if (read_size > 0) {
-        QByteArray to_return = QByteArray::fromRawData(m_data_buffer,read_size);
-        emit readyRead(to_return);
-    } else if (read_size <= 0) {
+    if (m_read_buffer.size() < m_read_size)
+        m_read_buffer.resize(m_read_size);
+
+    int total = 0;
+    bool hangup = false;
+    while (total < maxReadSize) {
+        if (total == m_read_buffer.size())
+            m_read_buffer.resize(std::min(2 * total, maxReadSize));
+        const ssize_t read_size = ::read(m_master_fd, m_read_buffer.data() + total, m_read_buffer.size() - total);
+        m_read_stats.reads++;
+        if (read_size < 0 && errno == EINTR)
+            continue;
+        if (read_size <= 0) {
+            hangup = true;
+            break;
+        }
+        total += read_size;
+        if (!hasPendingData(m_master_fd))
+            break;
+    }
+
+    while (m_read_size < total && m_read_size < maxReadSize)
+        m_read_size *= 2;
+    if (total < m_read_size / 4 && m_read_size > minReadSize) {
+        m_read_size /= 2;
+        if (m_read_buffer.size() > 4 * m_read_size) {
+            m_read_buffer.resize(m_read_size);
+            m_read_buffer.squeeze();
+        }
+    }
+    m_read_stats.readSize = m_read_size;
+
+    if (total)
+        emitChunk(QByteArray::fromRawData(m_read_buffer.constData(), total));
+
+    if (hangup) {
         delete m_reader;
+        m_reader = 0;
+        emit hangupReceived();
+    }
+}
+
+void YatPty::emitChunk(const QByteArray &data)
+{
+    m_read_stats.chunks++;
+    m_read_stats.bytes += data.size();
+    m_read_stats.largestChunk = std::max(m_read_stats.largestChunk, data.size());
+    emit readyRead(data);
+}
+
+void YatPty::setReadEnabled(bool enabled)
+{
+    if (enabled == m_read_enabled)
+        return;
+    m_read_enabled = enabled;
+
+    if (m_reader) {
+        m_reader->setEnabled(enabled);
+    } else if (m_reader_thread && enabled) {
+        // The reader does not announce data again until it has been taken,
+        // and the ring may have filled up in the meantime.
+        QMetaObject::invokeMethod(this, "readFromReader", Qt::QueuedConnection);
+    }
+}
+
+// Everything the reader thread has queued since the last call goes to the
+// parser as one chunk. While reading is disabled the data stays in the ring,
+// which makes the reader thread stop once it is full.
+void YatPty::readFromReader()
+{
+    if (!m_read_enabled || !m_reader_thread)
+        return;
+
+    m_read_buffer.clear();
+    const bool open = m_reader_thread->takeData(&m_read_buffer);
+    if (!m_read_buffer.isEmpty())
+        emitChunk(m_read_buffer);
+    if (!open) {
+        m_reader_thread->stop();
+        delete m_reader_thread;
+        m_reader_thread = 0;
         emit hangupReceived();
     }
 }
+
+PtyReader::PtyReader(int master_fd, QObject *parent)
+    : QThread(parent)
+    , m_master_fd(master_fd)
+    , m_ring(1 << 20)
+    , m_notified(false)
+    , m_waiting_for_space(false)
+    , m_hangup(false)
+    , m_quit(false)
+{
+    if (::pipe(m_wake_pipe) < 0) {
+        qFatal("couldn't create pipe: %s\n", strerror(errno));
+    }
+    ::fcntl(m_wake_pipe[0], F_SETFL, O_NONBLOCK);
+}
+
+PtyReader::~PtyReader()
+{
+    stop();
+    ::close(m_wake_pipe[0]);
+    ::close(m_wake_pipe[1]);
+}
+
+void PtyReader::stop()
+{
+    m_quit = true;
+    wake();
+    wait();
+}
+
+bool PtyReader::takeData(QByteArray *data)
+{
+    // Cleared first, so data arriving from here on is announced again.
+    m_notified = false;
+    // Read before draining, so that everything up to the hangup is taken.
+    const bool hangup = m_hangup;
+    m_ring.readAll(data);
+    if (m_waiting_for_space.exchange(false))
+        wake();
+    return !hangup;
+}
+
+void PtyReader::run()
+{
+    while (!m_quit) {
+        int free_size = 0;
+        char *buffer = m_ring.writeBuffer(&free_size);
+        if (!free_size) {
+            // The GUI thread only wakes us up if it sees the flag, so look
+            // again after setting it.
+            m_waiting_for_space = true;
+            buffer = m_ring.writeBuffer(&free_size);
+            if (free_size)
+                m_waiting_for_space = false;
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = m_wake_pipe[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = m_master_fd;
+        fds[1].events = free_size ? POLLIN : 0;
+        if (::poll(fds, free_size ? 2 : 1, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            char discard[64];
+            while (::read(m_wake_pipe[0], discard, sizeof discard) > 0) {
+            }
+        }
+
+        if (free_size && fds[1].revents) {
+            const ssize_t read_size = ::read(m_master_fd, buffer, free_size);
+            if (read_size > 0) {
+                m_ring.commitWrite(read_size);
+                notify();
+            } else if (read_size < 0 && errno == EINTR) {
+                continue;
+            } else {
+                m_hangup = true;
+                notify();
+                return;
+            }
+        }
+    }
+}
+
+void PtyReader::notify()
+{
+    if (!m_notified.exchange(true))
+        emit dataAvailable();
+}
+
+void PtyReader::wake()
+{
+    const char byte = 0;
+    if (::write(m_wake_pipe[1], &byte, 1) < 0) {
+        qDebug() << "Failed to wake up the pty reader";
+    }
+}
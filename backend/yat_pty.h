@@ -26,16 +26,82 @@
 #include <QtCore/QObject>
 #include <QtCore/QLinkedList>
 #include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+#include <atomic>
+
+#include "byte_ring.h"
 
 class QSocketNotifier;
 
+// Drains the master device into a ring on its own thread, so reading keeps up
+// while the GUI thread is busy. dataAvailable is only emitted again once the
+// GUI thread has taken the data announced by the previous one.
+class PtyReader : public QThread
+{
+    Q_OBJECT
+public:
+    PtyReader(int master_fd, QObject *parent = 0);
+    ~PtyReader();
+
+    void stop();
+
+    // Appends everything read so far to data. Returns false once the other
+    // end has hung up and data holds the last of it.
+    bool takeData(QByteArray *data);
+
+signals:
+    void dataAvailable();
+
+protected:
+    void run();
+
+private:
+    void notify();
+    void wake();
+
+    int m_master_fd;
+    int m_wake_pipe[2];
+    ByteRing m_ring;
+    std::atomic<bool> m_notified;
+    std::atomic<bool> m_waiting_for_space;
+    std::atomic<bool> m_hangup;
+    std::atomic<bool> m_quit;
+};
+
 class YatPty : public QObject
 {
     Q_OBJECT
 public:
+    struct ReadStats {
+        ReadStats()
+            : readSize(0)
+            , largestChunk(0)
+            , reads(0)
+            , chunks(0)
+            , bytes(0)
+        {
+        }
+
+        // Size of the read buffer for the next wakeup on the GUI thread.
+        int readSize;
+        int largestChunk;
+        // read() calls on the GUI thread, and readyRead emissions.
+        quint64 reads;
+        quint64 chunks;
+        quint64 bytes;
+    };
+
     YatPty();
     ~YatPty();
 
+    ReadStats readStats() const { return m_read_stats; }
+
+    // While disabled, nothing more is read from the child, so it blocks once
+    // the kernel buffer is full.
+    void setReadEnabled(bool enabled);
+    bool readEnabled() const { return m_read_enabled; }
+
     void write(const QByteArray &data);
 
     void setSize(int width, int pixelWidth, int height, int pixelHeight);
@@ -47,15 +113,23 @@ signals:
     void hangupReceived();
     void readyRead(const QByteArray &data);
 
+private slots:
+    void readFromReader();
+
 private:
     void readData();
+    void emitChunk(const QByteArray &data);
 
     pid_t m_terminal_pid;
     int m_master_fd;
     char m_slave_file_name[PATH_MAX];
     struct winsize *m_winsize;
-    char m_data_buffer[1024];
     QSocketNotifier *m_reader;
+    PtyReader *m_reader_thread;
+    QByteArray m_read_buffer;
+    int m_read_size;
+    ReadStats m_read_stats;
+    bool m_read_enabled;
 };
 
 #endif //YAT_PTY_H
@@ -32,6 +32,10 @@ Yat.TerminalScreen {
     property alias font: fontMetricText.font
     property real fontWidth: fontMetricText.averageCharacterWidth
     property real fontHeight: fontMetricText.height
+    // Draw the text with one QML Text item per style run instead of the
+    // scene graph renderer. The renderer falls back to them by itself when
+    // the scene graph does not use OpenGL.
+    property bool textItems: false
 
     anchors.fill: parent
     focus: true
@@ -105,6 +109,14 @@ Yat.TerminalScreen {
             width: parent.width
             height: screen.contentHeight * screenItem.fontHeight
 
+            Yat.TextRenderer {
+                anchors.fill: parent
+                screen: screenItem.textItems ? null : screenItem.screen
+                font: screenItem.font
+                fontWidth: screenItem.fontWidth
+                fontHeight: screenItem.fontHeight
+            }
+
             Selection {
                 characterHeight: fontHeight
                 characterWidth: fontWidth
@@ -9,11 +9,13 @@ include(../../backend/backend.pri)
 
 SOURCES += \
           plugin/terminal_screen.cpp \
+          plugin/terminal_text_renderer.cpp \
           plugin/object_destruct_item.cpp \
           plugin/yat_extension_plugin.cpp \
 
 HEADERS += \
           plugin/terminal_screen.h \
+          plugin/terminal_text_renderer.h \
           plugin/object_destruct_item.h \
           plugin/yat_extension_plugin.h \
 
@@ -20,12 +20,22 @@
 
 #include "terminal_screen.h"
 
+#include <algorithm>
+
 TerminalScreen::TerminalScreen(QQuickItem *parent)
     : QQuickItem(parent)
     , m_screen(new Screen(this))
+    , m_measure_latency(false)
+    , m_dispatched_at(0)
+    , m_latency(0)
+    , m_latency_total(0)
+    , m_latency_max(0)
+    , m_latency_count(0)
 {
     setFlag(QQuickItem::ItemAcceptsInputMethod);
     connect(m_screen, &Screen::hangup, this, &TerminalScreen::hangupReceived);
+    connect(m_screen, &Screen::frameRequested, this, &TerminalScreen::requestFrame);
+    m_clock.start();
 }
 
 TerminalScreen::~TerminalScreen()
@@ -70,3 +80,92 @@ void TerminalScreen::hangupReceived()
     emit aboutToBeDestroyed(this);
     deleteLater();
 }
+
+bool TerminalScreen::measureLatency() const
+{
+    return m_measure_latency;
+}
+
+void TerminalScreen::setMeasureLatency(bool measure)
+{
+    if (measure == m_measure_latency)
+        return;
+
+    m_measure_latency = measure;
+    m_dispatched_at = 0;
+    m_latency = 0;
+    m_latency_total = 0;
+    m_latency_max = 0;
+    m_latency_count = 0;
+    emit measureLatencyChanged();
+    emit latencyChanged();
+}
+
+qreal TerminalScreen::latency() const
+{
+    return m_latency / 1000000.;
+}
+
+qreal TerminalScreen::averageLatency() const
+{
+    return m_latency_count ? m_latency_total / 1000000. / m_latency_count : 0;
+}
+
+qreal TerminalScreen::maxLatency() const
+{
+    return m_latency_max / 1000000.;
+}
+
+// Changes are dispatched as the window prepares a frame, so at most once per
+// frame and in step with it, instead of from a timer.
+void TerminalScreen::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange) {
+        if (m_window)
+            m_window->disconnect(this);
+        m_window = value.window;
+        if (m_window) {
+            connect(m_window.data(), &QQuickWindow::afterAnimating, this, &TerminalScreen::dispatchFrame);
+            connect(m_window.data(), &QQuickWindow::frameSwapped, this, &TerminalScreen::frameSwapped,
+                    Qt::DirectConnection);
+        }
+        m_screen->setFramePaced(m_window);
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void TerminalScreen::requestFrame()
+{
+    if (m_window)
+        m_window->update();
+}
+
+void TerminalScreen::dispatchFrame()
+{
+    if (m_screen->dispatchFrame() && m_measure_latency) {
+        qint64 expected = 0;
+        m_dispatched_at.compare_exchange_strong(expected, m_clock.nsecsElapsed());
+    }
+}
+
+// Called on the render thread.
+void TerminalScreen::frameSwapped()
+{
+    const qint64 dispatched_at = m_dispatched_at.exchange(0);
+    if (dispatched_at) {
+        QMetaObject::invokeMethod(this, "latencyMeasured", Qt::QueuedConnection,
+                                  Q_ARG(qint64, m_clock.nsecsElapsed() - dispatched_at));
+    }
+}
+
+void TerminalScreen::latencyMeasured(qint64 nsecs)
+{
+    if (!m_measure_latency)
+        return;
+
+    m_latency = nsecs;
+    m_latency_total += nsecs;
+    m_latency_max = std::max(m_latency_max, nsecs);
+    m_latency_count++;
+    emit latencyChanged();
+}
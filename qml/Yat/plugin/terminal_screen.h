@@ -25,10 +25,15 @@
 #define TERMINALITEM_H
 
 #include <QtCore/QObject>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointer>
 #include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickWindow>
 #include <QInputMethodEvent>
 #include <QKeyEvent>
 
+#include <atomic>
+
 #include "screen.h"
 
 class TerminalScreen : public QQuickItem
@@ -36,24 +41,55 @@ class TerminalScreen : public QQuickItem
     Q_OBJECT
 
     Q_PROPERTY(Screen *screen READ screen CONSTANT)
+    Q_PROPERTY(bool measureLatency READ measureLatency WRITE setMeasureLatency NOTIFY measureLatencyChanged)
+    Q_PROPERTY(qreal latency READ latency NOTIFY latencyChanged)
+    Q_PROPERTY(qreal averageLatency READ averageLatency NOTIFY latencyChanged)
+    Q_PROPERTY(qreal maxLatency READ maxLatency NOTIFY latencyChanged)
 public:
     TerminalScreen(QQuickItem *parent = 0);
     ~TerminalScreen();
 
     Screen *screen() const;
 
+    // Time from a dispatch to the swap of the frame showing it, in ms.
+    bool measureLatency() const;
+    void setMeasureLatency(bool measure);
+    qreal latency() const;
+    qreal averageLatency() const;
+    qreal maxLatency() const;
+
     QVariant inputMethodQuery(Qt::InputMethodQuery query) const;
 
 public slots:
     void hangupReceived();
 signals:
     void aboutToBeDestroyed(TerminalScreen *screen);
+    void measureLatencyChanged();
+    void latencyChanged();
 
 protected:
     void inputMethodEvent(QInputMethodEvent *event);
+    void itemChange(ItemChange change, const ItemChangeData &value);
+
+private slots:
+    void requestFrame();
+    void dispatchFrame();
+    void frameSwapped();
+    void latencyMeasured(qint64 nsecs);
 
 private:
     Screen *m_screen;
+    QPointer<QQuickWindow> m_window;
+
+    bool m_measure_latency;
+    QElapsedTimer m_clock;
+    // Set on the GUI thread when a frame has changes, taken on the render
+    // thread when that frame is swapped.
+    std::atomic<qint64> m_dispatched_at;
+    qint64 m_latency;
+    qint64 m_latency_total;
+    qint64 m_latency_max;
+    int m_latency_count;
 };
 
 #endif // TERMINALITEM_H
@@ -0,0 +1,752 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "terminal_text_renderer.h"
+
+#include "char_width.h"
+#include "screen.h"
+#include "text_style.h"
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QtMath>
+#include <QtGui/QFontMetricsF>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
+#include <QtGui/QOpenGLShaderProgram>
+#include <QtGui/QPainter>
+#include <QtGui/qopengl.h>
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/QSGGeometryNode>
+#include <QtQuick/QSGMaterial>
+#include <QtQuick/QSGTexture>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+#include <QtQuick/QSGRendererInterface>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+Q_LOGGING_CATEGORY(lcTextRenderer, "yat.textrenderer", QtWarningMsg)
+
+static const int atlasWidth = 1024;
+static const int maxAtlasHeight = 4096;
+
+// Padding cells are covered by the wide glyph before them.
+static bool hasGlyph(QChar character)
+{
+    return character.unicode() > ' ' && !CharWidth::isPadding(character);
+}
+
+GlyphAtlas::GlyphAtlas()
+    : m_device_pixel_ratio(1)
+    , m_ascent(0)
+    , m_bold_ascent(0)
+    , m_next_slot(0)
+    , m_generation(0)
+{
+}
+
+void GlyphAtlas::reset(const QFont &font, qreal cell_width, qreal cell_height, qreal device_pixel_ratio)
+{
+    m_font = font;
+    m_bold_font = font;
+    m_bold_font.setBold(true);
+    m_device_pixel_ratio = device_pixel_ratio;
+    m_ascent = QFontMetricsF(m_font).ascent();
+    m_bold_ascent = QFontMetricsF(m_bold_font).ascent();
+
+    m_slot_size = QSize(qCeil(cell_width * device_pixel_ratio), qCeil(cell_height * device_pixel_ratio));
+    evict();
+}
+
+void GlyphAtlas::evict()
+{
+    const int columns = std::max(2, atlasWidth / m_slot_size.width());
+    // Byte ordered, so it can be uploaded as GL_RGBA on any host.
+    m_image = QImage(columns * m_slot_size.width(), 8 * m_slot_size.height(), QImage::Format_RGBA8888_Premultiplied);
+    m_image.fill(Qt::transparent);
+    {
+        QPainter painter(&m_image);
+        painter.fillRect(slot(0, false), Qt::white);
+    }
+
+    m_slots.clear();
+    for (QHash<QString, int> &slots : m_cluster_slots)
+        slots.clear();
+    m_next_slot = 1;
+    m_generation++;
+    m_dirty = m_image.rect();
+}
+
+QRect GlyphAtlas::glyph(QChar character, bool bold, bool wide)
+{
+    const quint32 key = character.unicode() | (bold ? 0x10000 : 0) | (wide ? 0x20000 : 0);
+    auto it = m_slots.constFind(key);
+    if (it != m_slots.constEnd())
+        return slot(*it, wide);
+
+    const int index = allocate(wide);
+    if (index < 0)
+        return QRect();
+    m_slots.insert(key, index);
+    return rasterize(index, QString(character), bold, wide);
+}
+
+QRect GlyphAtlas::glyph(const QString &cluster, bool bold, bool wide)
+{
+    QHash<QString, int> &slots = m_cluster_slots[(bold ? 1 : 0) | (wide ? 2 : 0)];
+    auto it = slots.constFind(cluster);
+    if (it != slots.constEnd())
+        return slot(*it, wide);
+
+    const int index = allocate(wide);
+    if (index < 0)
+        return QRect();
+    slots.insert(cluster, index);
+    return rasterize(index, cluster, bold, wide);
+}
+
+QRect GlyphAtlas::takeDirty()
+{
+    const QRect dirty = m_dirty;
+    m_dirty = QRect();
+    return dirty;
+}
+
+QRect GlyphAtlas::slot(int index, bool wide) const
+{
+    const int columns = m_image.width() / m_slot_size.width();
+    return QRect(QPoint((index % columns) * m_slot_size.width(), (index / columns) * m_slot_size.height()),
+                 QSize(m_slot_size.width() * (wide ? 2 : 1), m_slot_size.height()));
+}
+
+// Returns the first of the slots for a glyph, or -1 when the atlas is as big
+// as it gets.
+int GlyphAtlas::allocate(bool wide)
+{
+    const int columns = m_image.width() / m_slot_size.width();
+    // Both halves of a wide glyph go on the same row.
+    if (wide && m_next_slot % columns == columns - 1)
+        m_next_slot++;
+    const int end = m_next_slot + (wide ? 2 : 1);
+    while ((end - 1) / columns >= m_image.height() / m_slot_size.height()) {
+        if (m_image.height() * 2 > maxAtlasHeight)
+            return -1;
+        // Copying beyond the bottom fills the new half with transparent
+        // pixels.
+        m_image = m_image.copy(0, 0, m_image.width(), m_image.height() * 2);
+        m_generation++;
+        m_dirty = m_image.rect();
+    }
+
+    const int index = m_next_slot;
+    m_next_slot = end;
+    return index;
+}
+
+QRect GlyphAtlas::rasterize(int index, const QString &text, bool bold, bool wide)
+{
+    const QRect rect = slot(index, wide);
+    QPainter painter(&m_image);
+    painter.setClipRect(rect);
+    painter.translate(rect.topLeft());
+    painter.scale(m_device_pixel_ratio, m_device_pixel_ratio);
+    painter.setFont(bold ? m_bold_font : m_font);
+    painter.setPen(Qt::white);
+    painter.drawText(QPointF(0, bold ? m_bold_ascent : m_ascent), text);
+
+    m_dirty |= rect;
+    return rect;
+}
+
+namespace {
+
+struct GlyphVertex
+{
+    float x;
+    float y;
+    float tx;
+    float ty;
+    uchar r;
+    uchar g;
+    uchar b;
+    uchar a;
+};
+
+const QSGGeometry::AttributeSet &glyphAttributes()
+{
+    static const QSGGeometry::Attribute attributes[] = {
+        QSGGeometry::Attribute::create(0, 2, GL_FLOAT, true),
+        QSGGeometry::Attribute::create(1, 2, GL_FLOAT),
+        QSGGeometry::Attribute::create(2, 4, GL_UNSIGNED_BYTE)
+    };
+    static const QSGGeometry::AttributeSet set = { 3, sizeof(GlyphVertex), attributes };
+    return set;
+}
+
+// Keeps the atlas in one texture and uploads only the rows that changed.
+// The storage is only specified again when the image changes size.
+class AtlasTexture : public QSGTexture
+{
+public:
+    AtlasTexture()
+        : m_id(0)
+        , m_bind_options_dirty(true)
+    {
+    }
+    ~AtlasTexture()
+    {
+        if (m_id && QOpenGLContext::currentContext())
+            QOpenGLContext::currentContext()->functions()->glDeleteTextures(1, &m_id);
+    }
+
+    int textureId() const { return m_id; }
+    QSize textureSize() const { return m_size; }
+    bool hasAlphaChannel() const { return true; }
+    bool hasMipmaps() const { return false; }
+
+    void bind()
+    {
+        QOpenGLContext::currentContext()->functions()->glBindTexture(GL_TEXTURE_2D, m_id);
+        updateBindOptions(m_bind_options_dirty);
+        m_bind_options_dirty = false;
+    }
+
+    void upload(const QImage &image, const QRect &dirty)
+    {
+        QOpenGLFunctions *gl = QOpenGLContext::currentContext()->functions();
+        if (!m_id)
+            gl->glGenTextures(1, &m_id);
+        gl->glBindTexture(GL_TEXTURE_2D, m_id);
+        if (image.size() != m_size) {
+            m_size = image.size();
+            gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_size.width(), m_size.height(), 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, image.constBits());
+            m_bind_options_dirty = true;
+        } else {
+            // Whole rows, so the pixels are contiguous in the image.
+            gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, dirty.top(), m_size.width(), dirty.height(),
+                                GL_RGBA, GL_UNSIGNED_BYTE, image.constScanLine(dirty.top()));
+        }
+    }
+
+private:
+    GLuint m_id;
+    QSize m_size;
+    bool m_bind_options_dirty;
+};
+
+// Multiplies the color by the alpha of the atlas, so one material draws the
+// glyphs as well as the solid backgrounds.
+class GlyphMaterial : public QSGMaterial
+{
+public:
+    GlyphMaterial()
+        : m_texture(0)
+    {
+        setFlag(Blending);
+    }
+    ~GlyphMaterial()
+    {
+        delete m_texture;
+    }
+
+    QSGMaterialType *type() const
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+    QSGMaterialShader *createShader() const;
+
+    AtlasTexture *texture() const { return m_texture; }
+    void setTexture(AtlasTexture *texture)
+    {
+        delete m_texture;
+        m_texture = texture;
+    }
+
+private:
+    AtlasTexture *m_texture;
+};
+
+class GlyphMaterialShader : public QSGMaterialShader
+{
+public:
+    const char *vertexShader() const
+    {
+        return "attribute highp vec4 vertex;\n"
+               "attribute highp vec2 texCoord;\n"
+               "attribute lowp vec4 color;\n"
+               "uniform highp mat4 matrix;\n"
+               "varying highp vec2 sampleCoord;\n"
+               "varying lowp vec4 fragColor;\n"
+               "void main() {\n"
+               "    sampleCoord = texCoord;\n"
+               "    fragColor = color;\n"
+               "    gl_Position = matrix * vertex;\n"
+               "}\n";
+    }
+
+    const char *fragmentShader() const
+    {
+        return "uniform sampler2D texture;\n"
+               "uniform lowp float opacity;\n"
+               "varying highp vec2 sampleCoord;\n"
+               "varying lowp vec4 fragColor;\n"
+               "void main() {\n"
+               "    gl_FragColor = fragColor * (texture2D(texture, sampleCoord).a * opacity);\n"
+               "}\n";
+    }
+
+    char const *const *attributeNames() const
+    {
+        static const char *const names[] = { "vertex", "texCoord", "color", 0 };
+        return names;
+    }
+
+    void updateState(const RenderState &state, QSGMaterial *new_material, QSGMaterial *)
+    {
+        if (state.isMatrixDirty())
+            program()->setUniformValue(m_matrix_id, state.combinedMatrix());
+        if (state.isOpacityDirty())
+            program()->setUniformValue(m_opacity_id, state.opacity());
+        static_cast<GlyphMaterial *>(new_material)->texture()->bind();
+    }
+
+protected:
+    void initialize()
+    {
+        m_matrix_id = program()->uniformLocation("matrix");
+        m_opacity_id = program()->uniformLocation("opacity");
+    }
+
+private:
+    int m_matrix_id;
+    int m_opacity_id;
+};
+
+QSGMaterialShader *GlyphMaterial::createShader() const
+{
+    return new GlyphMaterialShader;
+}
+
+class TextRendererNode : public QSGNode
+{
+public:
+    GlyphMaterial material;
+    QHash<const Block *, QSGNode *> blocks;
+};
+
+// Collects the quads of one row, in cell coordinates of the item.
+class RowBuilder
+{
+public:
+    RowBuilder(const QSize &atlas_size, qreal device_pixel_ratio)
+        : m_atlas_size(atlas_size)
+        , m_device_pixel_ratio(device_pixel_ratio)
+    {
+    }
+
+    void addQuad(const QRectF &rect, const QRect &slot, QRgb color)
+    {
+        const float left = slot.left() / float(m_atlas_size.width());
+        const float top = slot.top() / float(m_atlas_size.height());
+        const float right = (slot.left() + slot.width()) / float(m_atlas_size.width());
+        const float bottom = (slot.top() + slot.height()) / float(m_atlas_size.height());
+        addVertices(rect, left, top, right, bottom, color);
+    }
+
+    // Samples the middle of the solid slot, so neighbouring slots never
+    // bleed into the edges.
+    void addSolid(const QRectF &rect, const QRect &solid, QRgb color)
+    {
+        const float x = (solid.left() + solid.width() / 2.f) / m_atlas_size.width();
+        const float y = (solid.top() + solid.height() / 2.f) / m_atlas_size.height();
+        addVertices(rect, x, y, x, y, color);
+    }
+
+    void addGlyph(qreal x, qreal y, const QRect &slot, QRgb color)
+    {
+        addQuad(QRectF(x, y, slot.width() / m_device_pixel_ratio, slot.height() / m_device_pixel_ratio), slot, color);
+    }
+
+    bool isEmpty() const { return m_vertices.isEmpty(); }
+
+    QSGGeometry *createGeometry() const
+    {
+        const int quads = m_vertices.size() / 4;
+        QSGGeometry *geometry = new QSGGeometry(glyphAttributes(), m_vertices.size(), quads * 6);
+        geometry->setDrawingMode(GL_TRIANGLES);
+        memcpy(geometry->vertexData(), m_vertices.constData(), m_vertices.size() * sizeof(GlyphVertex));
+        quint16 *indices = geometry->indexDataAsUShort();
+        for (int i = 0; i < quads; i++) {
+            const quint16 first = i * 4;
+            *indices++ = first;
+            *indices++ = first + 1;
+            *indices++ = first + 2;
+            *indices++ = first + 2;
+            *indices++ = first + 1;
+            *indices++ = first + 3;
+        }
+        return geometry;
+    }
+
+private:
+    void addVertices(const QRectF &rect, float left, float top, float right, float bottom, QRgb color)
+    {
+        const QRgb premultiplied = qPremultiply(color);
+        const uchar r = qRed(premultiplied);
+        const uchar g = qGreen(premultiplied);
+        const uchar b = qBlue(premultiplied);
+        const uchar a = qAlpha(premultiplied);
+        m_vertices.append({ float(rect.left()), float(rect.top()), left, top, r, g, b, a });
+        m_vertices.append({ float(rect.right()), float(rect.top()), right, top, r, g, b, a });
+        m_vertices.append({ float(rect.left()), float(rect.bottom()), left, bottom, r, g, b, a });
+        m_vertices.append({ float(rect.right()), float(rect.bottom()), right, bottom, r, g, b, a });
+    }
+
+    QSize m_atlas_size;
+    qreal m_device_pixel_ratio;
+    QVector<GlyphVertex> m_vertices;
+};
+
+}
+
+TerminalTextRenderer::TerminalTextRenderer(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_font_width(0)
+    , m_font_height(0)
+    , m_atlas_reset(true)
+    , m_atlas_generation(-1)
+{
+    setFlag(ItemHasContents);
+}
+
+TerminalTextRenderer::~TerminalTextRenderer()
+{
+    if (isActive())
+        m_screen->setBlockRenderer(0);
+}
+
+Screen *TerminalTextRenderer::screen() const
+{
+    return m_screen;
+}
+
+void TerminalTextRenderer::setScreen(Screen *screen)
+{
+    if (screen == m_screen)
+        return;
+
+    if (m_screen) {
+        if (isActive())
+            m_screen->setBlockRenderer(0);
+        disconnect(m_screen->colorPalette(), 0, this, 0);
+    }
+    releaseBlocks();
+
+    m_screen = screen;
+    if (m_screen)
+        connect(m_screen->colorPalette(), &ColorPalette::changed, this, &TerminalTextRenderer::markAllDirty);
+    updateActive(window());
+
+    emit screenChanged();
+    update();
+}
+
+bool TerminalTextRenderer::isActive() const
+{
+    return m_screen && m_screen->blockRenderer() == this;
+}
+
+// Takes over drawing the screen from its Text items once the item is in a
+// window that renders with OpenGL, and hands it back when that changes.
+void TerminalTextRenderer::updateActive(QQuickWindow *window)
+{
+    if (!m_screen)
+        return;
+
+    bool supported = window != 0;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+    if (supported && window->rendererInterface()->graphicsApi() != QSGRendererInterface::OpenGL) {
+        qCDebug(lcTextRenderer) << "The scene graph does not use OpenGL, drawing the screen with Text items";
+        supported = false;
+    }
+#endif
+    if (supported == isActive())
+        return;
+
+    if (supported) {
+        m_screen->setBlockRenderer(this);
+    } else {
+        m_screen->setBlockRenderer(0);
+        releaseBlocks();
+    }
+    update();
+}
+
+void TerminalTextRenderer::releaseBlocks()
+{
+    for (auto it = m_blocks.cbegin(); it != m_blocks.cend(); ++it)
+        m_released.append(it.key());
+    m_blocks.clear();
+}
+
+void TerminalTextRenderer::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange)
+        updateActive(value.window);
+    QQuickItem::itemChange(change, value);
+}
+
+QFont TerminalTextRenderer::font() const
+{
+    return m_font;
+}
+
+void TerminalTextRenderer::setFont(const QFont &font)
+{
+    if (font == m_font)
+        return;
+    m_font = font;
+    m_atlas_reset = true;
+    emit fontChanged();
+    update();
+}
+
+qreal TerminalTextRenderer::fontWidth() const
+{
+    return m_font_width;
+}
+
+void TerminalTextRenderer::setFontWidth(qreal width)
+{
+    if (width == m_font_width)
+        return;
+    m_font_width = width;
+    m_atlas_reset = true;
+    emit fontWidthChanged();
+    update();
+}
+
+qreal TerminalTextRenderer::fontHeight() const
+{
+    return m_font_height;
+}
+
+void TerminalTextRenderer::setFontHeight(qreal height)
+{
+    if (height == m_font_height)
+        return;
+    m_font_height = height;
+    m_atlas_reset = true;
+    emit fontHeightChanged();
+    update();
+}
+
+void TerminalTextRenderer::blockChanged(const Block *block, size_t line, int width, const TextCell *cells, int size)
+{
+    BlockRows &rows = m_blocks[block];
+    rows.line = line;
+    rows.width = width;
+    rows.cells.resize(size);
+    memcpy(rows.cells.data(), cells, size * sizeof(TextCell));
+    rows.dirty = true;
+    update();
+}
+
+void TerminalTextRenderer::blockReleased(const Block *block)
+{
+    if (m_blocks.remove(block)) {
+        m_released.append(block);
+        update();
+    }
+}
+
+void TerminalTextRenderer::markAllDirty()
+{
+    for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+        it->dirty = true;
+    update();
+}
+
+QSGNode *TerminalTextRenderer::updatePaintNode(QSGNode *old_node, UpdatePaintNodeData *)
+{
+    TextRendererNode *root = static_cast<TextRendererNode *>(old_node);
+    if (!isActive() || m_font_width <= 0 || m_font_height <= 0) {
+        delete root;
+        m_released.clear();
+        for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+            it->dirty = true;
+        return 0;
+    }
+
+    if (!root) {
+        root = new TextRendererNode;
+        m_atlas_reset = true;
+    }
+
+    for (const Block *block : m_released) {
+        if (!m_blocks.contains(block))
+            delete root->blocks.take(block);
+    }
+    m_released.clear();
+
+    const qreal device_pixel_ratio = window()->devicePixelRatio();
+    if (m_atlas_reset || device_pixel_ratio != m_atlas.devicePixelRatio()) {
+        m_atlas.reset(m_font, m_font_width, m_font_height, device_pixel_ratio);
+        m_atlas_reset = false;
+    }
+
+    // Rasterize everything the dirty rows need up front. Growing the atlas
+    // changes the texture coordinates of the rows that are already built.
+    // Once it is full, it starts over with only what is on screen now.
+    if (!rasterizeGlyphs()) {
+        m_atlas.evict();
+        if (!rasterizeGlyphs())
+            qCWarning(lcTextRenderer) << "Glyph atlas is too small for the screen, some characters are not drawn";
+    }
+    if (m_atlas.generation() != m_atlas_generation) {
+        for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+            it->dirty = true;
+        m_atlas_generation = m_atlas.generation();
+    }
+
+    // New glyphs only upload the rows of the atlas they are on.
+    const QRect dirty = m_atlas.takeDirty();
+    if (!dirty.isNull()) {
+        if (!root->material.texture())
+            root->material.setTexture(new AtlasTexture);
+        root->material.texture()->upload(m_atlas.image(), dirty);
+    }
+
+    for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it) {
+        if (!it->dirty)
+            continue;
+        QSGNode *&block_node = root->blocks[it.key()];
+        if (!block_node) {
+            block_node = new QSGNode;
+            root->appendChildNode(block_node);
+        }
+        buildRows(block_node, *it);
+        it->dirty = false;
+    }
+
+    return root;
+}
+
+// Returns false if some glyph did not fit in the atlas.
+bool TerminalTextRenderer::rasterizeGlyphs()
+{
+    if (m_atlas.generation() != m_atlas_generation) {
+        for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+            it->dirty = true;
+    }
+    const TextStyleTable &styles = m_screen->styleTable();
+    for (auto it = m_blocks.cbegin(); it != m_blocks.cend(); ++it) {
+        if (!it->dirty)
+            continue;
+        for (int i = 0; i < it->cells.size(); i++) {
+            const TextCell &cell = it->cells.at(i);
+            if (hasGlyph(cell.character)
+                    && cellGlyph(*it, i, styles.style(cell.style).style & TextStyle::Bold).isNull()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A cell followed by a padding cell has a wide glyph, drawn across both.
+QRect TerminalTextRenderer::cellGlyph(const BlockRows &rows, int index, bool bold)
+{
+    const QChar character = rows.cells.at(index).character;
+    const bool wide = index + 1 < rows.cells.size() && CharWidth::isPadding(rows.cells.at(index + 1).character);
+    if (ClusterTable::isCluster(character))
+        return m_atlas.glyph(m_screen->clusterTable().text(character), bold, wide);
+    return m_atlas.glyph(character, bold, wide);
+}
+
+void TerminalTextRenderer::buildRows(QSGNode *block_node, const BlockRows &rows)
+{
+    while (QSGNode *child = block_node->firstChild())
+        delete child;
+
+    TextRendererNode *root = static_cast<TextRendererNode *>(block_node->parent());
+    const TextStyleTable &styles = m_screen->styleTable();
+    const QRgb default_background = m_screen->defaultBackgroundColor().rgb();
+    const QRect solid = m_atlas.solid();
+    const qreal underline_height = std::max(1, qRound(m_font_height / 16));
+
+    const int size = rows.cells.size();
+    const int line_count = (std::max(size - 1, 0) / rows.width) + 1;
+    for (int row = 0; row < line_count; row++) {
+        RowBuilder builder(m_atlas.image().size(), m_atlas.devicePixelRatio());
+        const qreal y = (rows.line + row) * m_font_height;
+        const int row_start = row * rows.width;
+        const int row_end = std::min(row_start + rows.width, size);
+
+        // Backgrounds first, merged across cells of the same color.
+        for (int i = row_start; i < row_end;) {
+            const TextStyle &style = styles.style(rows.cells.at(i).style);
+            const QRgb background = style.style & TextStyle::Inverse ? style.foreground : style.background;
+            int end = i + 1;
+            while (end < row_end) {
+                const TextStyle &next = styles.style(rows.cells.at(end).style);
+                if ((next.style & TextStyle::Inverse ? next.foreground : next.background) != background)
+                    break;
+                end++;
+            }
+            if (background != default_background) {
+                builder.addSolid(QRectF((i - row_start) * m_font_width, y, (end - i) * m_font_width, m_font_height),
+                                 solid, background);
+            }
+            i = end;
+        }
+
+        for (int i = row_start; i < row_end; i++) {
+            const TextCell &cell = rows.cells.at(i);
+            const TextStyle &style = styles.style(cell.style);
+            const QRgb foreground = style.style & TextStyle::Inverse ? style.background : style.foreground;
+            const qreal x = (i - row_start) * m_font_width;
+            if (hasGlyph(cell.character)) {
+                const QRect slot = cellGlyph(rows, i, style.style & TextStyle::Bold);
+                if (!slot.isNull())
+                    builder.addGlyph(x, y, slot, foreground);
+            }
+            if (style.style & TextStyle::Underlined) {
+                builder.addSolid(QRectF(x, y + m_font_height - underline_height, m_font_width, underline_height),
+                                 solid, foreground);
+            }
+        }
+
+        if (builder.isEmpty())
+            continue;
+
+        QSGGeometryNode *node = new QSGGeometryNode;
+        node->setGeometry(builder.createGeometry());
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(&root->material);
+        block_node->appendChildNode(node);
+    }
+}
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef TERMINAL_TEXT_RENDERER_H
+#define TERMINAL_TEXT_RENDERER_H
+
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+#include <QtGui/QFont>
+#include <QtGui/QImage>
+#include <QtQuick/QQuickItem>
+
+#include "block.h"
+#include "block_renderer.h"
+
+class Screen;
+
+// Rasterizes glyphs on demand into one image, a slot of one cell each, or
+// two side by side for wide glyphs. Slot zero is solid, so backgrounds and
+// underlines can be drawn with the same texture as the text.
+class GlyphAtlas
+{
+public:
+    GlyphAtlas();
+
+    void reset(const QFont &font, qreal cell_width, qreal cell_height, qreal device_pixel_ratio);
+    // Drops every glyph, for when the atlas is full.
+    void evict();
+
+    // Returns the rectangle of the glyph in image pixels, rasterizing it
+    // first if it is not in the atlas yet, or a null rectangle if there is
+    // no room left for it. Clusters are keyed by their text.
+    QRect glyph(QChar character, bool bold, bool wide);
+    QRect glyph(const QString &cluster, bool bold, bool wide);
+    QRect solid() const { return slot(0, false); }
+
+    const QImage &image() const { return m_image; }
+    qreal devicePixelRatio() const { return m_device_pixel_ratio; }
+    // Bumped whenever the image changes size or glyphs are evicted, which
+    // moves every slot in texture coordinates.
+    int generation() const { return m_generation; }
+    // The part of the image that changed since the last call, or a null
+    // rectangle.
+    QRect takeDirty();
+
+private:
+    QRect slot(int index, bool wide) const;
+    int allocate(bool wide);
+    QRect rasterize(int index, const QString &text, bool bold, bool wide);
+
+    QFont m_font;
+    QFont m_bold_font;
+    QImage m_image;
+    QHash<quint32, int> m_slots;
+    // Indexed by bold and wide, as the two low bits.
+    QHash<QString, int> m_cluster_slots[4];
+    QSize m_slot_size;
+    qreal m_device_pixel_ratio;
+    qreal m_ascent;
+    qreal m_bold_ascent;
+    int m_next_slot;
+    int m_generation;
+    QRect m_dirty;
+};
+
+// Draws the blocks of a Screen straight into the scene graph, one geometry
+// node per row, instead of a QML Text item for every style run. Blinking
+// text is drawn steady. It needs OpenGL; on other scene graph backends, and
+// until the item is in a window, the screen keeps its Text items.
+class TerminalTextRenderer : public QQuickItem, public BlockRenderer
+{
+    Q_OBJECT
+
+    Q_PROPERTY(Screen *screen READ screen WRITE setScreen NOTIFY screenChanged)
+    Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+    Q_PROPERTY(qreal fontWidth READ fontWidth WRITE setFontWidth NOTIFY fontWidthChanged)
+    Q_PROPERTY(qreal fontHeight READ fontHeight WRITE setFontHeight NOTIFY fontHeightChanged)
+public:
+    TerminalTextRenderer(QQuickItem *parent = 0);
+    ~TerminalTextRenderer();
+
+    Screen *screen() const;
+    void setScreen(Screen *screen);
+
+    QFont font() const;
+    void setFont(const QFont &font);
+
+    qreal fontWidth() const;
+    void setFontWidth(qreal width);
+
+    qreal fontHeight() const;
+    void setFontHeight(qreal height);
+
+    void blockChanged(const Block *block, size_t line, int width, const TextCell *cells, int size);
+    void blockReleased(const Block *block);
+
+signals:
+    void screenChanged();
+    void fontChanged();
+    void fontWidthChanged();
+    void fontHeightChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *old_node, UpdatePaintNodeData *);
+    void itemChange(ItemChange change, const ItemChangeData &value);
+
+private slots:
+    void markAllDirty();
+
+private:
+    struct BlockRows {
+        size_t line;
+        int width;
+        QVector<TextCell> cells;
+        bool dirty;
+    };
+
+    bool isActive() const;
+    void updateActive(QQuickWindow *window);
+    void releaseBlocks();
+    bool rasterizeGlyphs();
+    QRect cellGlyph(const BlockRows &rows, int index, bool bold);
+    void buildRows(QSGNode *block_node, const BlockRows &rows);
+
+    QPointer<Screen> m_screen;
+    QFont m_font;
+    qreal m_font_width;
+    qreal m_font_height;
+
+    QHash<const Block *, BlockRows> m_blocks;
+    QVector<const Block *> m_released;
+
+    GlyphAtlas m_atlas;
+    bool m_atlas_reset;
+    int m_atlas_generation;
+};
+
+#endif // TERMINAL_TEXT_RENDERER_H
@@ -28,6 +28,7 @@
 #include <QQmlEngine>
 
 #include "terminal_screen.h"
+#include "terminal_text_renderer.h"
 #include "object_destruct_item.h"
 #include "screen.h"
 #include "text.h"
@@ -49,6 +50,7 @@ void YatExtensionPlugin::registerTypes(const char *uri)
     Q_ASSERT(uri == QByteArrayLiteral("Yat"));
     qmlRegisterType<TerminalScreen>("Yat", 1, 0, "TerminalScreen");
     qmlRegisterType<ObjectDestructItem>("Yat", 1, 0, "ObjectDestructItem");
+    qmlRegisterType<TerminalTextRenderer>("Yat", 1, 0, "TextRenderer");
     qmlRegisterType<Screen>();
     qmlRegisterType<Text>();
     qmlRegisterType<Cursor>();
@@ -69,6 +69,8 @@ private slots:
     void insertCharacters();
     void insertCharacters2Segments();
     void insertCharacters3Segments();
+    void styleIds();
+    void compact();
 };
 
 void tst_Block::replaceStart()
@@ -944,5 +946,52 @@ void tst_Block::insertCharacters3Segments()
     QCOMPARE(seventh_style.style, TextStyle::Bold);
 }
 
+void tst_Block::styleIds()
+{
+    BlockHandler blockHandler(true);
+    Block *block = blockHandler.block();
+    TextStyleTable &table = blockHandler.screen.styleTable();
+
+    QCOMPARE(table.intern(blockHandler.screen.defaultTextStyle()), blockHandler.screen.defaultStyleId());
+
+    TextStyle style = blockHandler.default_style;
+    style.style = TextStyle::Bold;
+    const quint16 bold = table.intern(style);
+    QVERIFY(bold != blockHandler.screen.defaultStyleId());
+    QCOMPARE(table.intern(style), bold);
+    QCOMPARE(table.style(bold).style, TextStyle::Styles(TextStyle::Bold));
+
+    block->replaceAtPos(3, QString("bold"), bold);
+    block->replaceAtPos(10, QString("also bold"), style);
+
+    QVector<TextStyleLine> style_list = block->style_list();
+    QCOMPARE(style_list.size(), 5);
+    QCOMPARE(style_list.at(1).style_id, bold);
+    QCOMPARE(style_list.at(3).style_id, bold);
+    QCOMPARE(style_list.at(4).style_id, blockHandler.screen.defaultStyleId());
+}
+
+void tst_Block::compact()
+{
+    BlockHandler blockHandler(true);
+    Block *block = blockHandler.block();
+
+    TextStyle style = blockHandler.default_style;
+    style.style = TextStyle::Bold;
+    block->replaceAtPos(5, QString("compact me"), style);
+    blockHandler.doneChanges();
+
+    const QString text = block->textLine();
+    const QVector<TextStyleLine> style_list = block->style_list();
+
+    block->compact();
+    QCOMPARE(block->textLine(), text);
+    QCOMPARE(block->style_list().size(), style_list.size());
+
+    // Dispatching rebuilds the text segments of a compacted block.
+    blockHandler.doneChanges();
+    QCOMPARE(block->textLine(), text);
+}
+
 #include <tst_block.moc>
 QTEST_MAIN(tst_Block);
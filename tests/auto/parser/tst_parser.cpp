@@ -27,6 +27,7 @@
 #include "../../../backend/screen.h"
 #include "../../../backend/screen_data.h"
 #include "../../../backend/cursor.h"
+#include "../../../backend/text_scanner.h"
 
 class tst_Parser : public QObject
 {
@@ -38,6 +39,25 @@ private slots:
 
     void xtermIndexed_data();
     void xtermIndexed();
+
+    void xtermTruecolor_data();
+    void xtermTruecolor();
+
+    void sgrAttributes_data();
+    void sgrAttributes();
+
+    void splitInput_data();
+    void splitInput();
+    void scrollRegion_data();
+    void scrollRegion();
+    void textScanner_data();
+    void textScanner();
+
+    void characterDecoding_data();
+    void characterDecoding();
+
+    void wideCharacters_data();
+    void wideCharacters();
 };
 
 void tst_Parser::setColor_data()
@@ -215,5 +235,251 @@ void tst_Parser::xtermIndexed()
     QCOMPARE(QColor(s.currentCursor()->currentTextStyle().background), s.colorPalette()->defaultBackground());
 }
 
+void tst_Parser::xtermTruecolor_data()
+{
+    QTest::addColumn<QByteArray>("input");
+
+    QTest::newRow("semicolons")       << QByteArray("\033[38;2;10;20;30;48;2;40;50;60m");
+    QTest::newRow("colons")           << QByteArray("\033[38:2:10:20:30;48:2:40:50:60m");
+    QTest::newRow("colorspace")       << QByteArray("\033[38:2::10:20:30;48:2:0:40:50:60m");
+    QTest::newRow("split attributes") << QByteArray("\033[38:2:10:20:30m\033[48:2:40:50:60m");
+}
+
+// SGR 38/48, 2: direct colors, with the values separated either way.
+void tst_Parser::xtermTruecolor()
+{
+    QFETCH(QByteArray, input);
+
+    Screen s;
+    Parser p(&s);
+    p.addData(input);
+
+    QCOMPARE(s.currentCursor()->currentTextStyle().foreground, qRgb(10, 20, 30));
+    QCOMPARE(s.currentCursor()->currentTextStyle().background, qRgb(40, 50, 60));
+}
+
+void tst_Parser::sgrAttributes_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<int>("style");
+
+    QTest::newRow("set")        << QByteArray("\033[1;4;5;7m") << int(TextStyle::Bold | TextStyle::Underlined | TextStyle::Blinking | TextStyle::Inverse);
+    QTest::newRow("unset")      << QByteArray("\033[1;4;7m\033[22;27m") << int(TextStyle::Underlined);
+    // Hidden text is not handled by the common SGR path.
+    QTest::newRow("slow unset") << QByteArray("\033[1;4;8;22m") << int(TextStyle::Underlined);
+    QTest::newRow("reset")      << QByteArray("\033[1;31;42m\033[0;4m") << int(TextStyle::Underlined);
+}
+
+void tst_Parser::sgrAttributes()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(int, style);
+
+    Screen s;
+    Parser p(&s);
+    p.addData(input);
+
+    QCOMPARE(int(s.currentCursor()->currentTextStyle().style), style);
+    if (input.contains("[0;")) {
+        QCOMPARE(QColor(s.currentCursor()->currentTextStyle().foreground), s.colorPalette()->defaultForeground());
+        QCOMPARE(QColor(s.currentCursor()->currentTextStyle().background), s.colorPalette()->defaultBackground());
+    }
+}
+
+void tst_Parser::splitInput_data()
+{
+    QTest::addColumn<QByteArray>("input");
+
+    QTest::newRow("plain")      << QByteArray("hello world");
+    QTest::newRow("newlines")   << QByteArray("one\r\ntwo\r\nthree");
+    QTest::newRow("sgr")        << QByteArray("\033[1;31mred\033[0m plain \033[38;5;100;48;5;7mxterm");
+    QTest::newRow("movement")   << QByteArray("abc\033[3;5Hxyz\033[1Adef\033[2Cg");
+    QTest::newRow("erase")      << QByteArray("abcdef\033[3D\033[K\r\nxyz\033[1K");
+    QTest::newRow("osc bel")    << QByteArray("\033]0;a title\007text");
+    QTest::newRow("charset")    << QByteArray("\033(0lqqk\033(Blqqk");
+    QTest::newRow("utf8")       << QByteArray("h\xc3\xa9llo w\xc3\xb6rld \xe2\x94\x80");
+    QTest::newRow("c0 in csi")  << QByteArray("ab\033[2\rC");
+    QTest::newRow("line breaks") << QByteArray("\033[1;3ra\nb\r\n\nc\n\r\n\nd\r\n\r\n");
+    QTest::newRow("sub params") << QByteArray("\033[4:0;38:5:100mx\033[38:2::1:2:3;1mbold");
+    QTest::newRow("su sd")      << QByteArray("\033[1;4rone\r\ntwo\r\nthree\033[2Sx\033[1T\033[9S");
+}
+
+// The parser must leave the screen in the same state whether it gets the
+// data in one go, a byte at a time, or split anywhere in between.
+void tst_Parser::splitInput()
+{
+    QFETCH(QByteArray, input);
+
+    Screen wholeScreen(0, true /* testMode */);
+    Parser wholeParser(&wholeScreen);
+    wholeParser.addData(input);
+
+    Screen byteScreen(0, true /* testMode */);
+    Parser byteParser(&byteScreen);
+    for (int i = 0; i < input.size(); i++)
+        byteParser.addData(input.mid(i, 1));
+
+    Screen halvesScreen(0, true /* testMode */);
+    Parser halvesParser(&halvesScreen);
+    halvesParser.addData(input.left(input.size() / 2));
+    halvesParser.addData(input.mid(input.size() / 2));
+
+    for (Screen *s : { &byteScreen, &halvesScreen }) {
+        Cursor *expected = wholeScreen.currentCursor();
+        Cursor *actual = s->currentCursor();
+        QCOMPARE(actual->new_x(), expected->new_x());
+        QCOMPARE(actual->new_y(), expected->new_y());
+        QCOMPARE(actual->currentTextStyle().style, expected->currentTextStyle().style);
+        QCOMPARE(actual->currentTextStyle().foreground, expected->currentTextStyle().foreground);
+        QCOMPARE(actual->currentTextStyle().background, expected->currentTextStyle().background);
+        QCOMPARE(s->title(), wholeScreen.title());
+
+        for (int row = 0; row < 4; row++) {
+            Block *expectedBlock = *wholeScreen.currentScreenData()->it_for_row(row);
+            Block *actualBlock = *s->currentScreenData()->it_for_row(row);
+            QCOMPARE(actualBlock->textLine(), expectedBlock->textLine());
+        }
+    }
+}
+
+void tst_Parser::scrollRegion_data()
+{
+    QTest::addColumn<QByteArray>("sequence");
+    QTest::addColumn<QString>("top");
+
+    QTest::newRow("su")   << QByteArray("\033[S")  << QString("b");
+    QTest::newRow("su 0") << QByteArray("\033[0S") << QString("b");
+    QTest::newRow("su 2") << QByteArray("\033[2S") << QString("c");
+    QTest::newRow("sd 0") << QByteArray("\033[0T") << QString();
+    QTest::newRow("sse")  << QByteArray("\033[Q")  << QString("a");
+    QTest::newRow("cpr")  << QByteArray("\033[R")  << QString("a");
+}
+
+void tst_Parser::scrollRegion()
+{
+    QFETCH(QByteArray, sequence);
+    QFETCH(QString, top);
+
+    Screen s(0, true /* testMode */);
+    Parser p(&s);
+    p.addData("a\r\nb\r\nc\r\nd");
+    p.addData(sequence);
+
+    QCOMPARE((*s.currentScreenData()->it_for_row(0))->textLine(), top);
+}
+
+void tst_Parser::textScanner_data()
+{
+    QTest::addColumn<int>("implementation");
+
+    QTest::newRow("scalar") << int(TextScanner::Scalar);
+    QTest::newRow("sse2") << int(TextScanner::SSE2);
+    QTest::newRow("avx2") << int(TextScanner::AVX2);
+}
+
+void tst_Parser::textScanner()
+{
+    QFETCH(int, implementation);
+
+    const TextScanner::Implementation original = TextScanner::implementation();
+    if (!TextScanner::setImplementation(TextScanner::Implementation(implementation)))
+        QSKIP("Not supported on this CPU");
+
+    // Put each kind of stop byte at every position of a buffer that is
+    // longer than two vector widths, and scan from a few offsets.
+    const QByteArray stops("\x00\x1b\x1f\x7f\x80\xff", 6);
+    for (char stop : stops) {
+        for (int size = 0; size < 70; size++) {
+            for (int pos = 0; pos <= size; pos++) {
+                QByteArray buffer(size, 'a');
+                if (pos < size)
+                    buffer[pos] = stop;
+                for (int from = 0; from <= qMin(size, 3); from++) {
+                    const int expected = from <= pos ? pos : size;
+                    QCOMPARE(TextScanner::findNonPrintable(buffer.constData(), from, size), expected);
+                }
+            }
+        }
+    }
+
+    TextScanner::setImplementation(original);
+}
+
+void tst_Parser::characterDecoding_data()
+{
+    QTest::addColumn<QList<QByteArray> >("chunks");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("ascii") << (QList<QByteArray>() << "hello") << QStringLiteral("hello");
+    QTest::newRow("utf8") << (QList<QByteArray>() << "a\xc3\xa6\xe2\x94\x80") << QStringLiteral("a\u00e6\u2500");
+    QTest::newRow("split utf8") << (QList<QByteArray>() << "a\xe2" << "\x94" << "\x80b") << QStringLiteral("a\u2500b");
+    QTest::newRow("invalid utf8") << (QList<QByteArray>() << "a\xc3b\xff") << QStringLiteral("a\ufffdb\ufffd");
+    QTest::newRow("overlong") << (QList<QByteArray>() << "\xc0\xafx\xe0\x80\xaf") << QStringLiteral("\ufffd\ufffdx\ufffd\ufffd\ufffd");
+    QTest::newRow("surrogate") << (QList<QByteArray>() << "\xed\xa0\x80y") << QStringLiteral("\ufffd\ufffd\ufffdy");
+    QTest::newRow("five bytes") << (QList<QByteArray>() << "\xf8\x88\x80\x80\x80") << QString(5, QChar(0xfffd));
+    QTest::newRow("astral") << (QList<QByteArray>() << "\xf0\x9f" << "\x98\x80") << QStringLiteral("\U0001f600");
+    QTest::newRow("dec graphics") << (QList<QByteArray>() << "\x1b(0\x0fqx\x1b(B\x0fq") << QStringLiteral("\u2500\u2502q");
+    QTest::newRow("nrc british") << (QList<QByteArray>() << "\x1b(A\x0f#1") << QStringLiteral("\u00a31");
+    QTest::newRow("nrc with utf8") << (QList<QByteArray>() << "\x1b(K\x0f[\xc3\xa6") << QStringLiteral("\u00c4\u00e6");
+}
+
+void tst_Parser::characterDecoding()
+{
+    QFETCH(QList<QByteArray>, chunks);
+    QFETCH(QString, expected);
+
+    Screen s(0, true /* testMode */);
+    Parser p(&s);
+    for (const QByteArray &chunk : chunks)
+        p.addData(chunk);
+
+    Block *block = *s.currentScreenData()->it_for_row(0);
+    QCOMPARE(block->textLine().left(expected.size()), expected);
+    QCOMPARE(s.currentCursor()->new_x(), expected.size());
+}
+
+void tst_Parser::wideCharacters_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QString>("cells");
+    QTest::addColumn<QString>("selected");
+    QTest::addColumn<int>("x");
+
+    QTest::newRow("cjk") << QByteArray("a\xe4\xb8\xad\xe6\x96\x87b") << QStringLiteral("a\u4e2d\u200b\u6587\u200bb") << QStringLiteral("a\u4e2d\u6587b") << 6;
+    QTest::newRow("emoji") << QByteArray("\xf0\x9f\x98\x80!") << QStringLiteral("\U0001f600\u200b!") << QStringLiteral("\U0001f600!") << 3;
+    QTest::newRow("astral") << QByteArray("\xf0\x9d\x90\x80\xf0\x9d\x90\x81b") << QStringLiteral("\U0001d400\U0001d401b") << QStringLiteral("\U0001d400\U0001d401b") << 3;
+    QTest::newRow("astral combining") << QByteArray("\xf0\x9d\x90\x80\xcc\x81b") << QStringLiteral("\U0001d400\u0301b") << QStringLiteral("\U0001d400\u0301b") << 2;
+    QTest::newRow("combining") << QByteArray("e\xcc\x81x") << QStringLiteral("\u00e9x") << QStringLiteral("\u00e9x") << 2;
+    QTest::newRow("combining later") << QByteArray("e\x1b[m\xcc\x81x") << QStringLiteral("\u00e9x") << QStringLiteral("\u00e9x") << 2;
+    QTest::newRow("combining wide") << QByteArray("\xe4\xb8\xad\x1b[m\xcc\x81x") << QStringLiteral("\u4e2d\u0301\u200bx") << QStringLiteral("\u4e2d\u0301x") << 3;
+    QTest::newRow("hangul jamo") << QByteArray("\xe1\x84\x80\xe1\x85\xa1") << QStringLiteral("\uac00\u200b") << QStringLiteral("\uac00") << 2;
+    QTest::newRow("zero width") << QByteArray("x\xe2\x80\x8dy\xcc\xb8") << QStringLiteral("x\u200dy\u0338") << QStringLiteral("x\u200dy\u0338") << 2;
+    QTest::newRow("variation selector") << QByteArray("\xe2\x9d\xa4\xef\xb8\x8f\xf0\x9f\x91\x8d") << QStringLiteral("\u2764\ufe0f\U0001f44d\u200b") << QStringLiteral("\u2764\ufe0f\U0001f44d") << 3;
+    QTest::newRow("leading mark") << QByteArray("\xcc\x81x") << QStringLiteral("x") << QStringLiteral("x") << 1;
+    QTest::newRow("overwrite half") << QByteArray("\xe4\xb8\xad\xe6\x96\x87\x1b[2Gx") << QStringLiteral(" x\u6587\u200b") << QStringLiteral(" x\u6587") << 2;
+    QTest::newRow("wrap") << QByteArray("\x1b[80G\xe4\xb8\xad") << QString(80, QChar(' ')) + QStringLiteral("\u4e2d\u200b") << QString(80, QChar(' ')) + QStringLiteral("\u4e2d") << 2;
+}
+
+void tst_Parser::wideCharacters()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QString, cells);
+    QFETCH(QString, selected);
+    QFETCH(int, x);
+
+    Screen s(0, true /* testMode */);
+    Parser p(&s);
+    p.addData(data);
+
+    // A cell per column, with the clusters spelled out.
+    Block *block = *s.currentScreenData()->it_for_row(0);
+    const QString line = block->textLine();
+    QString layout;
+    s.clusterTable().appendText(&layout, line.constData(), line.size());
+    QCOMPARE(layout, cells);
+    QCOMPARE(s.currentScreenData()->selection(QPoint(0, 0), QPoint(line.size() % 80, line.size() / 80)), selected);
+    QCOMPARE(s.currentCursor()->new_x(), x);
+}
+
 #include <tst_parser.moc>
 QTEST_MAIN(tst_Parser);
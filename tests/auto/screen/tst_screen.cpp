@@ -23,10 +23,31 @@
 
 #include "../../../backend/block.h"
 #include <QtTest/QtTest>
+#include <QtCore/QBuffer>
 
 #include "../../../backend/screen.h"
 #include "../../../backend/screen_data.h"
 #include "../../../backend/cursor.h"
+#include "../../../backend/block_renderer.h"
+
+class CountingRenderer : public BlockRenderer
+{
+public:
+    void blockChanged(const Block *block, size_t line, int width, const TextCell *cells, int size)
+    {
+        Q_UNUSED(block);
+        Q_UNUSED(width);
+        Q_UNUSED(cells);
+        Q_UNUSED(size);
+        lines.append(line);
+    }
+    void blockReleased(const Block *block)
+    {
+        Q_UNUSED(block);
+    }
+
+    QVector<size_t> lines;
+};
 
 class tst_Screen : public QObject
 {
@@ -34,6 +55,19 @@ class tst_Screen : public QObject
 
 private slots:
     void construct();
+    void rowLookupAfterScroll();
+    void scrollInOneStep();
+    void floodSkipsHiddenRows();
+    void readBackpressure();
+    void scrollbackLimits();
+    void scrollbackSpill();
+    void scrollbackSpillCompaction();
+    void scrollbackLineIndex();
+    void scrollbackViewportDiff();
+    void lazyReflow();
+    void selectionText();
+    void styleReclamation();
+    void clusterReclamation();
 };
 
 void tst_Screen::construct()
@@ -52,5 +86,420 @@ void tst_Screen::construct()
     QVERIFY(s.currentCursor()->visible());
 }
 
+void tst_Screen::rowLookupAfterScroll()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    // Scroll the whole screen, which only moves the row index along.
+    for (int i = 0; i < 40; i++) {
+        data->replace(QPoint(0, bottom), QString::number(i), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    for (int row = 0; row < bottom; row++) {
+        Block *block = *data->it_for_row(row);
+        QCOMPARE(block->textLine(), QString::number(40 - bottom + row));
+        QCOMPARE(block->screenIndex(), row);
+        QCOMPARE(*data->it_for_block(block), block);
+    }
+
+    // Scroll a region, which shifts the entries between the margins.
+    data->insertLines(10, 5, 1);
+    QCOMPARE((*data->it_for_row(4))->textLine(), QString::number(40 - bottom + 4));
+    QCOMPARE((*data->it_for_row(5))->textLine(), QString::number(40 - bottom + 6));
+    QCOMPARE((*data->it_for_row(9))->textLine(), QString::number(40 - bottom + 10));
+    QCOMPARE((*data->it_for_row(10))->textLine(), QString());
+    QCOMPARE((*data->it_for_row(11))->textLine(), QString::number(40 - bottom + 11));
+}
+
+void tst_Screen::scrollInOneStep()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    for (int row = 0; row < s.height(); row++)
+        data->replace(QPoint(0, row), QString::number(row), s.defaultStyleId(), true);
+
+    // Three lines scroll out of the top of rows 5-10.
+    data->insertLines(10, 5, 3);
+    QCOMPARE((*data->it_for_row(4))->textLine(), QString("4"));
+    QCOMPARE((*data->it_for_row(5))->textLine(), QString("8"));
+    QCOMPARE((*data->it_for_row(7))->textLine(), QString("10"));
+    QCOMPARE((*data->it_for_row(8))->textLine(), QString());
+    QCOMPARE((*data->it_for_row(10))->textLine(), QString());
+    QCOMPARE((*data->it_for_row(11))->textLine(), QString("11"));
+
+    // And back down again.
+    data->moveLines(8, 5, 3);
+    QCOMPARE((*data->it_for_row(5))->textLine(), QString());
+    QCOMPARE((*data->it_for_row(7))->textLine(), QString());
+    QCOMPARE((*data->it_for_row(8))->textLine(), QString("8"));
+    QCOMPARE((*data->it_for_row(10))->textLine(), QString("10"));
+
+    // Scrolling the whole screen moves all four lines to scrollback at once.
+    data->insertLines(s.height() - 1, 0, 4);
+    QCOMPARE(data->contentHeight(), s.height() + 4);
+    QCOMPARE((*data->it_for_row(0))->textLine(), QString("4"));
+    QCOMPARE((*data->it_for_row(4))->textLine(), QString("8"));
+    QCOMPARE((*data->it_for_row(s.height() - 5))->textLine(), QString::number(s.height() - 1));
+    QCOMPARE((*data->it_for_row(s.height() - 1))->textLine(), QString());
+
+    // A long run of line feeds on a one line screen goes a line at a time.
+    s.setHeight(1);
+    s.dispatchChanges();
+    s.setScrollbackSize(-1);
+    const int pushed_before = data->scrollbackHeight();
+    data->replace(QPoint(0, 0), QString("last"), s.defaultStyleId(), true);
+    data->insertLines(0, 0, 100000);
+    QCOMPARE(int(data->scrollbackHeight()), pushed_before + 100000);
+    QCOMPARE(data->getDoubleClickSelectionRange(0, pushed_before).end, QPoint(4, pushed_before));
+}
+
+void tst_Screen::floodSkipsHiddenRows()
+{
+    CountingRenderer renderer;
+    Screen s;
+    Screen rendered;
+    rendered.setBlockRenderer(&renderer);
+    QSignalSpy created(&s, &Screen::textCreated);
+
+    // Ten screenfuls between two dispatches.
+    Screen *screens[] = { &s, &rendered };
+    for (Screen *screen : screens) {
+        ScreenData *data = screen->currentScreenData();
+        const int bottom = screen->height() - 1;
+        screen->setScrollbackSize(-1);
+        screen->setFastScroll(true);
+        for (int i = 0; i < 10 * screen->height(); i++) {
+            data->replace(QPoint(0, bottom), QString::number(i), screen->defaultStyleId(), true);
+            data->insertLines(bottom, 0, 1);
+        }
+        screen->dispatchChanges();
+    }
+
+    // Only the rows in view got anything to show them.
+    QVERIFY(created.count() > 0);
+    QVERIFY(created.count() <= s.height());
+    const size_t first_on_screen = rendered.currentScreenData()->scrollbackHeight();
+    QVERIFY(renderer.lines.size() > 0);
+    QVERIFY(renderer.lines.size() <= rendered.height());
+    for (size_t line : renderer.lines)
+        QVERIFY(line >= first_on_screen);
+}
+
+void tst_Screen::readBackpressure()
+{
+    Screen s(0, true);
+    s.setReadBacklogLimit(64 * 1024);
+    s.setParseTimeLimit(1);
+
+    // Far more than the limit in one read. Only the first slices are parsed
+    // right away, and reading pauses.
+    QByteArray flood;
+    while (flood.size() < 4 * 1024 * 1024)
+        flood += "line of output\r\n";
+    s.readData(flood);
+    QVERIFY(s.readBacklog() > 0);
+    QVERIFY(s.readBacklog() < flood.size());
+    QVERIFY(!s.pty()->readEnabled());
+
+    // The rest is parsed on later turns of the event loop, and reading
+    // resumes once it has been parsed and dispatched.
+    const int backlog = s.readBacklog();
+    QTRY_VERIFY(s.readBacklog() < backlog);
+    QTRY_COMPARE_WITH_TIMEOUT(s.readBacklog(), 0, 30000);
+    QTRY_VERIFY(s.pty()->readEnabled());
+    QCOMPARE(s.undispatchedBytes(), 0);
+}
+
+void tst_Screen::scrollbackLimits()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    for (int i = 0; i < 1000; i++) {
+        data->replace(QPoint(0, bottom), QString::number(i), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    QCOMPARE(data->contentHeight(), s.height() + 500);
+
+    // Shrinking drops the oldest lines.
+    s.setScrollbackSize(100);
+    QCOMPARE(data->contentHeight(), s.height() + 100);
+    QCOMPARE(int(data->scrollbackHeight()), 100);
+
+    // Without a line limit, the memory limit decides.
+    s.setScrollbackSize(-1);
+    QCOMPARE(s.scrollbackSize(), -1);
+    for (int i = 0; i < 5000; i++) {
+        data->replace(QPoint(0, bottom), QString::number(i), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    QCOMPARE(int(data->scrollbackHeight()), 5100);
+
+    const size_t memory = data->scrollbackMemory();
+    s.setScrollbackMemoryLimit(memory / 2);
+    QVERIFY(data->scrollbackMemory() <= memory / 2);
+    QVERIFY(data->scrollbackHeight() < 5100);
+    QVERIFY(data->scrollbackHeight() > 0);
+
+    s.dispatchChanges();
+    QCOMPARE(s.scrollbackLines(), int(data->scrollbackHeight()));
+    QCOMPARE(s.scrollbackMemory(), qint64(data->scrollbackMemory()));
+}
+
+void tst_Screen::scrollbackSpill()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    s.setScrollbackSize(-1);
+    s.setScrollbackMemoryLimit(16 * 1024);
+    s.setScrollbackSpill(true);
+    // Each line is written just before it leaves the top, so line n holds n.
+    for (int i = 0; i < 3000; i++) {
+        data->replace(QPoint(0, 0), QString("%1 x").arg(i), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+
+    // Nothing was evicted, and the oldest lines read back from disk.
+    QCOMPARE(int(data->scrollbackHeight()), 3000);
+    QVERIFY(data->scrollbackMemory() < 64 * 1024);
+    for (int line : { 0, 7, 1234, 2999 }) {
+        const SelectionRange range = data->getDoubleClickSelectionRange(0, line);
+        QCOMPARE(range.start, QPoint(0, line));
+        QCOMPARE(range.end, QPoint(QString::number(line).size(), line));
+    }
+
+    // Turning spilling off drops what was spilled.
+    s.setScrollbackSpill(false);
+    QVERIFY(data->scrollbackHeight() < 3000);
+}
+
+void tst_Screen::scrollbackSpillCompaction()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    // With a line limit, old spilled pages keep being dropped while new ones
+    // are spilled. The space they took is used again.
+    s.setScrollbackSize(1000);
+    s.setScrollbackMemoryLimit(4 * 1024);
+    s.setScrollbackSpill(true);
+    for (int i = 0; i < 50000; i++) {
+        data->replace(QPoint(0, 0), QString("%1 %2").arg(i).arg(i * 7919 % 10007), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    QCOMPARE(int(data->scrollbackHeight()), 1000);
+    QVERIFY(data->scrollbackSpillFileSize() > 0);
+    QVERIFY(data->scrollbackSpillFileSize() < 128 * 1024);
+
+    // What is left still reads back.
+    const int first = 50000 - 1000;
+    for (int line : { 0, 1, 500, 999 }) {
+        const SelectionRange range = data->getDoubleClickSelectionRange(0, line);
+        QCOMPARE(range.end, QPoint(QString::number(first + line).size(), line));
+    }
+}
+
+// Checks that content line n, up to lines, holds the number first + n.
+static void verifyNumberedLines(ScreenData *data, int first, int lines)
+{
+    for (int line = 0; line < lines; line++) {
+        const QString expected = QString::number(first + line);
+        const SelectionRange range = data->getDoubleClickSelectionRange(0, line);
+        QCOMPARE(range.start, QPoint(0, line));
+        QCOMPARE(range.end, QPoint(expected.size(), line));
+        QCOMPARE(data->selection(range.start, range.end), expected);
+    }
+}
+
+void tst_Screen::scrollbackLineIndex()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    // Each line is numbered as it leaves the top, so line n of the
+    // scrollback holds first + n. Every line is looked up, which takes in
+    // the first and last ones and both sides of every page boundary. Only a
+    // few lines are left in the open page, so most of the memory is in
+    // sealed pages.
+    s.setScrollbackSize(-1);
+    const int count = 8 * 128 + 6;
+    for (int i = 0; i < count; i++) {
+        data->replace(QPoint(0, 0), QString::number(i), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    QCOMPARE(int(data->scrollbackHeight()), count);
+    verifyNumberedLines(data, 0, count);
+
+    // Trimming to a size drops lines from the middle of the oldest page.
+    s.setScrollbackSize(700);
+    QCOMPARE(int(data->scrollbackHeight()), 700);
+    verifyNumberedLines(data, count - 700, 700);
+
+    // Trimming to a memory limit.
+    s.setScrollbackMemoryLimit(data->scrollbackMemory() / 2);
+    const int trimmed = data->scrollbackHeight();
+    QVERIFY(trimmed < 700);
+    QVERIFY(trimmed > 200);
+    verifyNumberedLines(data, count - trimmed, trimmed);
+
+    // Growing the screen takes back more lines than fit in a page, and they
+    // are looked up on screen, right after the scrollback.
+    const int reclaimed = 150;
+    s.setHeight(s.height() + reclaimed);
+    s.dispatchChanges();
+    QCOMPARE(int(data->scrollbackHeight()), trimmed - reclaimed);
+    verifyNumberedLines(data, count - trimmed, trimmed);
+}
+
+void tst_Screen::scrollbackViewportDiff()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    s.setScrollbackSize(-1);
+    for (int i = 0; i < 1000; i++) {
+        data->replace(QPoint(0, 0), QString::number(i), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    s.dispatchChanges();
+    s.ensureVisibleLines(500);
+
+    // Every line has one segment. Scrolling down a line gives back the one
+    // of the line leaving and takes one from the pool for the line coming
+    // in, also when either of them crosses into another page.
+    for (int top_line = 501; top_line <= 620; top_line++) {
+        const Screen::TextSegmentStats before = s.textSegmentStats();
+        s.ensureVisibleLines(top_line);
+        const Screen::TextSegmentStats after = s.textSegmentStats();
+        QCOMPARE(after.released - before.released, quint64(1));
+        QCOMPARE(after.acquired - before.acquired, quint64(1));
+        QCOMPARE(after.created, before.created);
+    }
+}
+
+void tst_Screen::lazyReflow()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    s.setScrollbackSize(-1);
+    for (int i = 0; i < 1000; i++) {
+        const QString line = QString::number(i).leftJustified(71, 'x');
+        data->replace(QPoint(0, bottom), line, s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    QCOMPARE(data->contentHeight(), 1025);
+
+    // Every written line wraps once at the new width, but the scrollback
+    // gets there a slice at a time.
+    s.setWidth(40);
+    s.dispatchChanges();
+    QTRY_COMPARE(data->contentHeight(), 2025);
+}
+
+void tst_Screen::selectionText()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    s.setScrollbackSize(-1);
+    // Each line is written just before it leaves the top, so line n holds n.
+    for (int i = 0; i < 300; i++) {
+        data->replace(QPoint(0, 0), QString("%1 x").arg(i), s.defaultStyleId(), true);
+        data->insertLines(bottom, 0, 1);
+    }
+    QCOMPARE(int(data->scrollbackHeight()), 300);
+
+    QCOMPARE(data->selection(QPoint(1, 298), QPoint(3, 299)), QString("98 x\n299"));
+    QCOMPARE(data->selection(QPoint(1, 298), QPoint(0, 300)), QString("98 x\n299 x\n"));
+
+    // Streaming it out gives the same text.
+    const QString all = data->selection(QPoint(0, 0), QPoint(0, 300));
+    QCOMPARE(all.count('\n'), 300);
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(data->writeSelection(QPoint(0, 0), QPoint(0, 300), &buffer));
+    QCOMPARE(buffer.data(), all.toUtf8());
+}
+
+void tst_Screen::styleReclamation()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    const int bottom = s.height() - 1;
+
+    TextStyle kept;
+    kept.foreground = qRgb(255, 0, 0);
+    const quint16 kept_in_scrollback = s.styleTable().intern(kept);
+    kept.foreground = qRgb(0, 0, 255);
+    const quint16 kept_on_screen = s.styleTable().intern(kept);
+
+    // A sealed page of scrollback with one styled line in it.
+    s.setScrollbackSize(-1);
+    data->replace(QPoint(0, bottom), QString("red"), kept_in_scrollback, true);
+    for (int i = 0; i < 200; i++)
+        data->insertLines(bottom, 0, 1);
+    data->replace(QPoint(0, 0), QString("blue"), kept_on_screen, true);
+
+    // More styles than there are ids, only ever one of them in use.
+    TextStyle style;
+    const int count = 70000;
+    for (int i = 1; i <= count; i++) {
+        style.foreground = QRgb(i);
+        data->replace(QPoint(0, 1), QString("x"), s.styleTable().intern(style), true);
+    }
+
+    const TextCell &last = (*data->it_for_row(1))->cells().at(0);
+    QCOMPARE(s.styleTable().style(last.style).foreground, QRgb(count));
+    QCOMPARE(s.styleTable().style(kept_in_scrollback).foreground, qRgb(255, 0, 0));
+    QCOMPARE(s.styleTable().style(kept_on_screen).foreground, qRgb(0, 0, 255));
+    QVERIFY(s.styleTable().size() < 0x10000);
+}
+
+void tst_Screen::clusterReclamation()
+{
+    Screen s;
+    ScreenData *data = s.currentScreenData();
+    ClusterTable &clusters = s.clusterTable();
+    const int bottom = s.height() - 1;
+
+    // A sealed page of scrollback with one cluster in it, and one more on
+    // screen.
+    const QString in_scrollback = QStringLiteral("\U0001d400");
+    const QString on_screen = QStringLiteral("x\u0338");
+    s.setScrollbackSize(-1);
+    data->replace(QPoint(0, bottom), QString(clusters.intern(in_scrollback)), s.defaultStyleId(), false);
+    for (int i = 0; i < 200; i++)
+        data->insertLines(bottom, 0, 1);
+    data->replace(QPoint(0, 0), QString(clusters.intern(on_screen)), s.defaultStyleId(), false);
+    const QChar in_scrollback_id = clusters.intern(in_scrollback);
+    const QChar on_screen_id = clusters.intern(on_screen);
+
+    // More clusters than there are ids, only ever one of them in use.
+    const int count = 5000;
+    for (int i = 0; i < count; i++) {
+        const uint code_point = 0x10000 + i;
+        clusters.reserve(1);
+        const QChar cluster = clusters.intern(QString::fromUcs4(&code_point, 1));
+        QVERIFY(cluster != QChar(QChar::ReplacementCharacter));
+        data->replace(QPoint(0, 1), QString(cluster), s.defaultStyleId(), false);
+    }
+
+    const uint last = 0x10000 + count - 1;
+    QCOMPARE(clusters.text((*data->it_for_row(1))->cells().at(0).character), QString::fromUcs4(&last, 1));
+    QCOMPARE(clusters.text(in_scrollback_id), in_scrollback);
+    QCOMPARE(clusters.text(on_screen_id), on_screen);
+}
+
 #include <tst_screen.moc>
 QTEST_MAIN(tst_Screen);
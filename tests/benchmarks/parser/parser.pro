@@ -0,0 +1,8 @@
+CONFIG += testcase benchmark
+QT += testlib quick
+CONFIG -= app_bundle
+
+include(../../../backend/backend.pri)
+
+SOURCES += \
+    tst_bench_parser.cpp
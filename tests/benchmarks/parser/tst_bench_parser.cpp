@@ -0,0 +1,341 @@
+/******************************************************************************
+ * Copyright (C) 2017 Robin Burchell <robin+git@viroteck.net>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include "../../../backend/block.h"
+#include <QtTest/QtTest>
+
+#include "../../../backend/screen.h"
+#include "../../../backend/parser.h"
+#include "../../../backend/cursor.h"
+
+// Replays terminal output through the parser and reports the throughput of
+// each stage, in MB/s and ns per input byte:
+//
+//  - parse: Parser::addData with model updates disabled, which runs the
+//    state machine, skips printable runs and collects parameters, but
+//    leaves the screen alone.
+//  - update: Parser::addData on a headless screen, which parses and changes
+//    the model. The model update on its own is this less parse, as both
+//    run the same parser.
+//  - dispatch: Screen::dispatchChanges after every slice, on its own.
+//
+// The built in workloads are generated, so runs can be compared. Recordings
+// of real sessions (from `script -q -c htop htop.log`, say) are replayed as
+// well when YAT_BENCHMARK_CORPUS names the directory they are in.
+
+static const int workloadSize = 1024 * 1024;
+// The parser is fed in the same slices as Screen::parseReadBacklog uses.
+static const int sliceSize = 16 * 1024;
+
+class Random
+{
+public:
+    explicit Random(quint32 seed) : m_state(seed) {}
+    int bounded(int n)
+    {
+        m_state = m_state * 1103515245u + 12345u;
+        return int((m_state >> 16) % quint32(n));
+    }
+
+private:
+    quint32 m_state;
+};
+
+static QByteArray number(int n)
+{
+    return QByteArray::number(n);
+}
+
+static QByteArray moveTo(int row, int column)
+{
+    return "\x1b[" + number(row) + ";" + number(column) + "H";
+}
+
+static QByteArray asciiLog()
+{
+    static const char *const levels[] = { "INFO ", "DEBUG", "WARN ", "INFO " };
+    Random random(1);
+    QByteArray out;
+    for (int i = 0; out.size() < workloadSize; i++) {
+        out += "2017-06-02 14:" + number(10 + i / 6000 % 50) + ":" + number(10 + i / 100 % 50) + "." + number(100 + i % 900);
+        out += QByteArray(" ") + levels[random.bounded(4)] + " [worker-" + number(random.bounded(8)) + "] ";
+        out += "GET /api/v1/items/" + number(random.bounded(100000)) + " served in " + number(random.bounded(500)) + " ms\r\n";
+    }
+    return out;
+}
+
+// What gcc prints with -fdiagnostics-color.
+static QByteArray compilerOutput()
+{
+    Random random(2);
+    QByteArray out;
+    for (int i = 0; out.size() < workloadSize; i++) {
+        const QByteArray name = "count" + number(i);
+        out += "\x1b[01m\x1b[Ksrc/module" + number(i % 17) + ".cpp:" + number(random.bounded(900) + 1) + ":5:\x1b[m\x1b[K ";
+        if (random.bounded(3) == 0)
+            out += "\x1b[01;31m\x1b[Kerror: \x1b[m\x1b[K'\x1b[01m\x1b[K" + name + "\x1b[m\x1b[K' was not declared in this scope\r\n";
+        else
+            out += "\x1b[01;35m\x1b[Kwarning: \x1b[m\x1b[Kunused variable '\x1b[01m\x1b[K" + name + "\x1b[m\x1b[K' [\x1b[01;35m\x1b[K-Wunused-variable\x1b[m\x1b[K]\r\n";
+        out += "     int \x1b[01;35m\x1b[K" + name + "\x1b[m\x1b[K = 0;\r\n";
+        out += "         \x1b[01;35m\x1b[K^" + QByteArray(name.size() - 1, '~') + "\x1b[m\x1b[K\r\n";
+    }
+    return out;
+}
+
+static QByteArray utf8Text()
+{
+    const QStringList lines = {
+        QStringLiteral("\u65e5\u672c\u8a9e\u306e\u30c6\u30ad\u30b9\u30c8\u3068 ASCII \u304c\u6df7\u3056\u3063\u305f\u884c"),
+        QStringLiteral("\u4e2d\u6587\u6587\u672c\uff0c\u5305\u542b\u5168\u89d2\u6807\u70b9\u3002"),
+        QStringLiteral("\ud55c\uad6d\uc5b4 \ud14d\uc2a4\ud2b8 \uc608\uc81c"),
+        QStringLiteral("Stra\u00dfe, na\u00efve caf\u00e9, \u0107evap\u010di\u0107i, \u0394\u03b5\u03bb\u03c4\u03b1"),
+        QStringLiteral("e\u0301 a\u0308 n\u0303 \U0001f600 \U0001f680 \u2714 done"),
+    };
+    QByteArray out;
+    for (int i = 0; out.size() < workloadSize; i++)
+        out += number(i) + ": " + lines.at(i % lines.size()).toUtf8() + "\r\n";
+    return out;
+}
+
+// Scrolling down a syntax highlighted file in vim: scroll the text area a
+// line, draw the new line, then update the ruler.
+static QByteArray vimScroll()
+{
+    static const char *const lines[] = {
+        "    \x1b[33mif\x1b[m (\x1b[36mcount\x1b[m > \x1b[31m",
+        "    \x1b[32mreturn\x1b[m \x1b[35mstd::min\x1b[m(value, \x1b[31m",
+        "    \x1b[34m// Keep the last entry around, see \x1b[m\x1b[34m#",
+        "    \x1b[32mint\x1b[m index = \x1b[31m",
+    };
+    Random random(3);
+    QByteArray out;
+    for (int line = 1; out.size() < workloadSize; line++) {
+        out += "\x1b[?25l\x1b[1;24r" + moveTo(24, 1) + "\n\x1b[r" + moveTo(24, 1);
+        out += "\x1b[33m" + QByteArray(5 - number(line).size(), ' ') + number(line) + " \x1b[m";
+        out += lines[random.bounded(4)] + number(random.bounded(1000)) + "\x1b[m;\x1b[K";
+        out += moveTo(25, 63) + number(line) + "," + number(random.bounded(40) + 1) + "\x1b[K";
+        out += moveTo(25, 76) + number(line % 100) + "%" + moveTo(24, 7) + "\x1b[?25h";
+    }
+    return out;
+}
+
+// A full htop frame: CPU meters, the header and a page of processes, one of
+// them highlighted.
+static QByteArray htopRefresh()
+{
+    Random random(4);
+    QByteArray out;
+    for (int frame = 0; out.size() < workloadSize; frame++) {
+        out += "\x1b[?25l";
+        for (int cpu = 0; cpu < 4; cpu++) {
+            const int used = random.bounded(41);
+            const int user = used * 2 / 3;
+            out += moveTo(cpu + 1, 1) + "\x1b[1m\x1b[36m  " + number(cpu + 1) + "\x1b[39m\x1b[22m[";
+            out += "\x1b[32m" + QByteArray(user, '|') + "\x1b[31m" + QByteArray(used - user, '|');
+            out += "\x1b[30m\x1b[1m" + QByteArray(40 - used, ' ') + number(used * 5 / 2) + "." + number(random.bounded(10)) + "%\x1b[39m\x1b[22m]";
+        }
+        out += moveTo(6, 1) + "\x1b[30m\x1b[42m  PID USER      PRI  NI  VIRT   RES   SHR S CPU% MEM%   TIME+  Command\x1b[K";
+        for (int row = 7; row <= 24; row++) {
+            out += moveTo(row, 1) + (row == 7 + frame % 18 ? "\x1b[30m\x1b[46m" : "\x1b[39;49m");
+            out += " " + number(1000 + random.bounded(9000)) + " robin      20   0  " + number(100 + random.bounded(900)) + "M ";
+            out += number(10 + random.bounded(90)) + "M  " + number(random.bounded(10)) + "M S  ";
+            out += number(random.bounded(100)) + ".0  1.2  0:0" + number(random.bounded(10)) + ".12 ";
+            out += "\x1b[1m/usr/bin/process\x1b[22m --option=" + number(row) + "\x1b[K";
+        }
+        out += "\x1b[m" + moveTo(25, 1) + "F1\x1b[30;46mHelp  \x1b[mF2\x1b[30;46mSetup \x1b[mF10\x1b[30;46mQuit\x1b[K\x1b[m";
+    }
+    return out;
+}
+
+// Dialog boxes drawn with the DEC line drawing set, as ncurses does.
+static QByteArray ncursesBoxes()
+{
+    Random random(5);
+    QByteArray out;
+    for (int i = 0; out.size() < workloadSize; i++) {
+        const int top = 1 + random.bounded(14);
+        const int left = 1 + random.bounded(50);
+        const int height = 3 + random.bounded(9);
+        const int width = 6 + random.bounded(24);
+        out += "\x1b[3" + number(random.bounded(8)) + ";4" + number(random.bounded(8)) + "m\x1b(0\x0f";
+        out += moveTo(top, left) + "l" + QByteArray(width - 2, 'q') + "k";
+        for (int row = 1; row < height - 1; row++)
+            out += moveTo(top + row, left) + "x" + QByteArray(width - 2, ' ') + "x";
+        out += moveTo(top + height - 1, left) + "m" + QByteArray(width - 2, 'q') + "j";
+        out += "\x1b(B\x0f" + moveTo(top, left + 2) + "\x1b[1m Box " + number(i) + " \x1b[m";
+    }
+    return out;
+}
+
+template <typename Slice>
+static void forEachSlice(const QByteArray &data, Slice slice)
+{
+    for (int i = 0; i < data.size(); i += sliceSize)
+        slice(QByteArray::fromRawData(data.constData() + i, std::min(sliceSize, data.size() - i)));
+}
+
+class Throughput
+{
+public:
+    Throughput() : m_bytes(0), m_nsecs(0) {}
+
+    void add(qint64 bytes, qint64 nsecs) { m_bytes += bytes; m_nsecs += nsecs; }
+    double nsPerByte() const { return m_bytes ? double(m_nsecs) / m_bytes : 0; }
+
+private:
+    qint64 m_bytes;
+    qint64 m_nsecs;
+};
+
+static void report(const char *stage, double ns_per_byte)
+{
+    if (ns_per_byte > 0)
+        qDebug("%s: %.1f MB/s, %.2f ns/byte", stage, 1e9 / ns_per_byte / (1024 * 1024), ns_per_byte);
+}
+
+class tst_Bench_Parser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void parse_data() { addWorkloadRows(); }
+    void parse();
+    void update_data() { addWorkloadRows(); }
+    void update();
+    void dispatch_data() { addWorkloadRows(); }
+    void dispatch();
+
+private:
+    void addWorkloadRows();
+
+    struct Workload {
+        QByteArray name;
+        QByteArray data;
+    };
+    QVector<Workload> m_workloads;
+    // The parse time of each workload, to tell the update on its own.
+    QHash<QByteArray, double> m_parse_ns_per_byte;
+};
+
+void tst_Bench_Parser::initTestCase()
+{
+    m_workloads.append({ "ascii log", asciiLog() });
+    m_workloads.append({ "compiler output", compilerOutput() });
+    m_workloads.append({ "utf8 text", utf8Text() });
+    m_workloads.append({ "vim scroll", vimScroll() });
+    m_workloads.append({ "htop refresh", htopRefresh() });
+    m_workloads.append({ "ncurses boxes", ncursesBoxes() });
+
+    const QByteArray corpus = qgetenv("YAT_BENCHMARK_CORPUS");
+    if (corpus.isEmpty())
+        return;
+    const QDir dir(QString::fromLocal8Bit(corpus));
+    for (const QFileInfo &info : dir.entryInfoList(QDir::Files, QDir::Name)) {
+        QFile file(info.filePath());
+        if (file.open(QIODevice::ReadOnly))
+            m_workloads.append({ info.fileName().toUtf8(), file.readAll() });
+        else
+            qWarning() << "Could not read" << info.filePath();
+    }
+}
+
+void tst_Bench_Parser::addWorkloadRows()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    for (const Workload &workload : m_workloads)
+        QTest::newRow(workload.name.constData()) << workload.data;
+}
+
+void tst_Bench_Parser::parse()
+{
+    QFETCH(QByteArray, data);
+
+    Screen screen(0, true /* testMode */);
+    Parser parser(&screen);
+    parser.setModelUpdatesEnabled(false);
+    screen.dispatchChanges(); // get geometry valid.
+
+    Throughput parse;
+    QElapsedTimer timer;
+    QBENCHMARK {
+        timer.start();
+        forEachSlice(data, [&](const QByteArray &slice) { parser.addData(slice); });
+        parse.add(data.size(), timer.nsecsElapsed());
+    }
+    QCOMPARE(screen.currentCursor()->new_x(), 0);
+    QCOMPARE(screen.currentCursor()->new_y(), 0);
+
+    report("parse", parse.nsPerByte());
+    m_parse_ns_per_byte.insert(QTest::currentDataTag(), parse.nsPerByte());
+}
+
+void tst_Bench_Parser::update()
+{
+    QFETCH(QByteArray, data);
+
+    Screen screen(0, true /* testMode */);
+    Parser parser(&screen);
+    screen.dispatchChanges(); // get geometry valid.
+
+    Throughput update;
+    QElapsedTimer timer;
+    QBENCHMARK {
+        timer.start();
+        forEachSlice(data, [&](const QByteArray &slice) { parser.addData(slice); });
+        update.add(data.size(), timer.nsecsElapsed());
+        screen.dispatchChanges();
+    }
+
+    report("parse and update", update.nsPerByte());
+    const double parse_ns_per_byte = m_parse_ns_per_byte.value(QTest::currentDataTag());
+    if (parse_ns_per_byte > 0 && parse_ns_per_byte < update.nsPerByte())
+        report("update", update.nsPerByte() - parse_ns_per_byte);
+}
+
+void tst_Bench_Parser::dispatch()
+{
+    QFETCH(QByteArray, data);
+
+    Screen screen(0, true /* testMode */);
+    Parser parser(&screen);
+    screen.dispatchChanges(); // get geometry valid.
+
+    Throughput dispatch;
+    QElapsedTimer timer;
+    QBENCHMARK {
+        forEachSlice(data, [&](const QByteArray &slice) {
+            parser.addData(slice);
+            timer.start();
+            screen.dispatchChanges();
+            dispatch.add(slice.size(), timer.nsecsElapsed());
+        });
+    }
+
+    report("dispatch", dispatch.nsPerByte());
+}
+
+#include <tst_bench_parser.moc>
+QTEST_MAIN(tst_Bench_Parser);